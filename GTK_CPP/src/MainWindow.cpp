@@ -15,16 +15,21 @@
 #include <cmath>     // For M_PI, std::abs
 #include <sigc++/sigc++.h> // For sigc::mem_fun
 
+using colorlines::Ball;
+using colorlines::BallColor;
+
 MainWindow::MainWindow()
-  : m_gameGrid(9, 9),
+  : m_gameGrid(),
     m_pathfinder(&m_gameGrid), // Pass address of m_gameGrid
-    m_solver(&m_gameGrid),   // Pass address of m_gameGrid
+    m_journal(&m_gameGrid),
+    m_turnResolver(&m_gameGrid, &m_journal),
     m_ballSelected(false),
     m_selectedRow(-1),
     m_selectedCol(-1),
     m_score(0),
     m_gameOver(false),
-    m_newGameButton("New Game") {
+    m_newGameButton("New Game"),
+    m_undoButton("Undo") {
     set_title("Color Lines GTK");
     set_default_size(450, 600);
 
@@ -33,10 +38,14 @@ MainWindow::MainWindow()
     mainBox->set_margin(10);
     set_child(*mainBox);
 
-    // New Game Button
+    // New Game and Undo buttons
+    auto buttonBox = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL, 10);
+    buttonBox->set_halign(Gtk::Align::CENTER);
     m_newGameButton.signal_clicked().connect(sigc::mem_fun(*this, &MainWindow::onNewGameClicked));
-    m_newGameButton.set_halign(Gtk::Align::CENTER);
-    mainBox->append(m_newGameButton);
+    buttonBox->append(m_newGameButton);
+    m_undoButton.signal_clicked().connect(sigc::mem_fun(*this, &MainWindow::onUndoClicked));
+    buttonBox->append(m_undoButton);
+    mainBox->append(*buttonBox);
 
     // Score Label
     m_scoreLabel.set_text("Score: 0");
@@ -109,11 +118,27 @@ void MainWindow::onNewGameClicked() {
     m_selectedCol = -1;
     m_gameOverLabel.set_text(""); // Clear game over message
 
-    m_gameGrid.addRandomBalls(5); // Add initial balls for the new game
-    drawBallsOnGrid(); // Redraw the grid with new balls
+    // Add the initial balls; lines they happen to form are cleared like spawned lines
+    applyTurnResult(m_turnResolver.spawnBalls(5));
 
-    // Check if the newly added balls immediately form lines or if the game is over
-    checkLinesAndScore(false); // 'false' because no player move initiated this
+    // The opening position is not undoable
+    m_journal.clear();
+    m_undoButton.set_sensitive(false);
+}
+
+void MainWindow::onUndoClicked() {
+    if (!m_journal.canUndo()) {
+        return;
+    }
+    std::cout << "Undo clicked." << std::endl;
+    m_score = m_journal.undoTurn(); // Restores board, spawn RNG and the score before the turn
+    m_scoreLabel.set_text("Score: " + std::to_string(m_score));
+    m_gameOver = false;
+    m_gameOverLabel.set_text("");
+    m_ballSelected = false;
+    m_undoButton.set_sensitive(m_journal.canUndo());
+    m_positionSnapshot.publish(m_gameGrid);
+    drawBallsOnGrid();
 }
 
 
@@ -121,6 +146,7 @@ void MainWindow::on_drawingArea_draw(const Cairo::RefPtr<Cairo::Context>& cr, in
     const Gdk::RGBA GRID_LINE_COLOR("black");
     const Gdk::RGBA CELL_BG_COLOR("white");
     const Gdk::RGBA SELECTED_CELL_HIGHLIGHT_COLOR("lightgray"); // For selected ball's cell
+    const Gdk::RGBA LEGAL_TARGET_COLOR("honeydew"); // Empty cells the selected ball can move to
 
     std::map<BallColor, Gdk::RGBA> BALL_COLORS;
     BALL_COLORS[BallColor::RED] = Gdk::RGBA("red");
@@ -140,6 +166,12 @@ void MainWindow::on_drawingArea_draw(const Cairo::RefPtr<Cairo::Context>& cr, in
     double offset_x = (width - actual_grid_render_size) / 2.0;
     double offset_y = (height - actual_grid_render_size) / 2.0;
 
+    // All legal destinations of the selected ball, from one reachability query
+    colorlines::Bitboard legalTargets;
+    if (m_ballSelected) {
+        legalTargets = m_pathfinder.getReachableCells(m_selectedRow, m_selectedCol);
+    }
+
     cr->save();
     cr->translate(offset_x, offset_y);
 
@@ -151,6 +183,8 @@ void MainWindow::on_drawingArea_draw(const Cairo::RefPtr<Cairo::Context>& cr, in
             // Highlight selected cell
             if (m_ballSelected && r == m_selectedRow && c == m_selectedCol) {
                 Gdk::Cairo::set_source_rgba(cr, SELECTED_CELL_HIGHLIGHT_COLOR);
+            } else if (legalTargets.test(m_gameGrid.cellIndex(r, c))) {
+                Gdk::Cairo::set_source_rgba(cr, LEGAL_TARGET_COLOR);
             } else {
                 Gdk::Cairo::set_source_rgba(cr, CELL_BG_COLOR);
             }
@@ -195,14 +229,15 @@ void MainWindow::onCellClicked(int r, int c) {
         if (m_gameGrid.isCellEmpty(r, c)) {
             // Clicked on an empty cell, attempt to move
             std::cout << "Attempting to move from (" << m_selectedRow << ", " << m_selectedCol << ") to (" << r << ", " << c << ")" << std::endl;
-            if (m_pathfinder.canReach(m_selectedRow, m_selectedCol, r, c)) {
+            if (m_pathfinder.getReachableCells(m_selectedRow, m_selectedCol).test(m_gameGrid.cellIndex(r, c))) {
                 std::cout << "Path found!" << std::endl;
-                BallColor color = m_gameGrid.getBall(m_selectedRow, m_selectedCol).getColor();
-                m_gameGrid.removeBall(m_selectedRow, m_selectedCol);
-                m_gameGrid.placeBall(r, c, color);
+                m_journal.beginTurn(m_score);
+                m_undoButton.set_sensitive(true);
 
                 m_ballSelected = false; // Deselect after moving
-                checkLinesAndScore(true); // Balls moved, check for lines, add new balls if no lines
+                // Move, clear lines, add new balls if no lines, all in one go
+                applyTurnResult(m_turnResolver.playTurn(m_gameGrid.cellIndex(m_selectedRow, m_selectedCol),
+                                                        m_gameGrid.cellIndex(r, c), 3));
             } else {
                 std::cout << "Invalid move: No path." << std::endl;
                 // Keep ball selected or deselect? Game rules vary. Let's deselect for simplicity.
@@ -237,73 +272,24 @@ void MainWindow::onCellClicked(int r, int c) {
     drawBallsOnGrid(); // Redraw to reflect selection changes or moves
 }
 
-int MainWindow::calculateScore(int ballsInLine) {
-    if (ballsInLine < 5) return 0;
-    // Example: 5 balls = 10, 6 = 10+12=22, 7 = 22+14=36 etc. (base 10, +2 for each extra ball)
-    // A simpler scoring: 10 points for 5 balls, 5 more for each additional ball
-    return 10 + (ballsInLine - 5) * 5;
-}
-
-void MainWindow::checkLinesAndScore(bool ballsMovedAndNoLinesFormedByPlayer) {
-    if (m_gameOver) return; // Don't process if already game over
-
-    std::vector<std::pair<int, int>> lines = m_solver.findLines();
-
-    if (!lines.empty()) {
-        std::cout << "Lines found! Number of balls to remove: " << lines.size() << std::endl;
-        for (const auto& pos : lines) {
-            m_gameGrid.removeBall(pos.first, pos.second);
-        }
-        m_score += calculateScore(lines.size());
+void MainWindow::applyTurnResult(const colorlines::TurnResult& result) {
+    if (result.cleared.any()) {
+        std::cout << "Lines found! Number of balls to remove: " << result.cleared.count() << std::endl;
+    }
+    if (result.spawnCleared.any()) {
+        std::cout << "Newly added balls formed lines! Balls removed: " << result.spawnCleared.count() << std::endl;
+    }
+    if (result.score != 0) {
+        m_score += result.score;
         m_scoreLabel.set_text("Score: " + std::to_string(m_score));
-
-        // Player cleared lines, does not add new balls this turn.
-        // The board might be full now, check for game over.
-        if (m_gameGrid.isFull()) {
-             m_gameOver = true;
-             m_gameOverLabel.set_markup("<span size='large' weight='bold' foreground='red'>Game Over! Grid Full!</span>");
-             std::cout << "Game Over! Grid became full after clearing lines." << std::endl;
-        }
-    } else {
-        // No lines were formed by the player's move OR this is an initial check.
-        if (ballsMovedAndNoLinesFormedByPlayer) {
-            // Player moved a ball, but it didn't form a line. Add new balls.
-            std::cout << "Move successful, no lines formed by player. Adding new balls." << std::endl;
-            std::vector<std::pair<int, int>> newBallsPositions = m_gameGrid.addRandomBalls(3);
-
-            if (newBallsPositions.empty() && m_gameGrid.isFull()) {
-                 // No space for new balls and grid is full. Game Over.
-                 m_gameOver = true;
-                 m_gameOverLabel.set_markup("<span size='large' weight='bold' foreground='red'>Game Over! No Space!</span>");
-                 std::cout << "Game Over! No space to add new balls and grid is full." << std::endl;
-            } else {
-                // New balls were added (or there was space). Check if THEY formed lines.
-                std::vector<std::pair<int, int>> newLinesFromAddedBalls = m_solver.findLines();
-                if (!newLinesFromAddedBalls.empty()) {
-                    std::cout << "Newly added balls formed lines! Balls to remove: " << newLinesFromAddedBalls.size() << std::endl;
-                    for (const auto& pos : newLinesFromAddedBalls) {
-                        m_gameGrid.removeBall(pos.first, pos.second);
-                    }
-                    // Score for these? Some games do, some don't. Let's not add to score for this.
-                    // m_score += calculateScore(newLinesFromAddedBalls.size());
-                    // m_scoreLabel.set_text("Score: " + std::to_string(m_score));
-                    std::cout << "Lines formed by new balls cleared." << std::endl;
-
-                    if (m_gameGrid.isFull()) { // Check again after auto-clear
-                         m_gameOver = true;
-                         m_gameOverLabel.set_markup("<span size='large' weight='bold' foreground='red'>Game Over! Grid Full!</span>");
-                         std::cout << "Game Over! Grid is full after adding balls and auto-clearing." << std::endl;
-                    }
-                }
-            }
-        } else if (!ballsMovedAndNoLinesFormedByPlayer && m_gameGrid.isFull()) {
-            // This case is for initial setup (onNewGameClicked calls with false)
-            // If grid is full immediately after adding first balls and no lines formed.
-            m_gameOver = true;
-            m_gameOverLabel.set_markup("<span size='large' weight='bold' foreground='red'>Game Over! Grid Full on Start!</span>");
-            std::cout << "Game Over! Grid is full on initial ball placement and no lines." << std::endl;
-        }
     }
+    if (result.gameOver) {
+        m_gameOver = true;
+        m_gameOverLabel.set_markup("<span size='large' weight='bold' foreground='red'>Game Over! Grid Full!</span>");
+        std::cout << "Game Over! The grid is full." << std::endl;
+    }
+    // The turn is complete; let readers on other threads see the new position.
+    m_positionSnapshot.publish(m_gameGrid);
     // Always redraw at the end of a turn or check.
     drawBallsOnGrid();
 }
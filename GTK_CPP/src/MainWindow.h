@@ -8,18 +8,31 @@
 #include <gtkmm/button.h> // For Gtk::Button
 #include "GameGrid.h"
 #include "Pathfinder.h"
-#include "Solver.h"
+#include "Rules.h"
+#include "TurnResolver.h"
+#include "MoveJournal.h"
+#include "Snapshot.h"
+#include <utility>
+#include <vector>
 
 class MainWindow : public Gtk::ApplicationWindow {
 public:
+    // Line length, directions and scoring of this frontend; any colorlines::Ruleset works.
+    using GameRules = colorlines::FlatRules;
+
     MainWindow();
 
+    // Latest finished position, safe to read from analysis threads without locking.
+    // Published by the UI thread after every turn, new game and undo.
+    const colorlines::Snapshot<colorlines::Board<9, 9>>& getPositionSnapshot() const { return m_positionSnapshot; }
+
 private:
     void drawBallsOnGrid(); // Will now just call m_drawingArea.queue_draw()
     void onCellClicked(int r, int c);
-    void checkLinesAndScore(bool ballsMoved);
-    int calculateScore(int ballsInLine);
+    // Updates score, game-over state and display from a resolved turn.
+    void applyTurnResult(const colorlines::TurnResult& result);
     void onNewGameClicked(); // Handler for New Game button
+    void onUndoClicked(); // Handler for Undo button
 
     // Drawing handler for the game board
     void on_drawingArea_draw(const Cairo::RefPtr<Cairo::Context>& cr, int width, int height);
@@ -27,9 +40,11 @@ private:
 protected:
     // Gtk::Grid m_grid;      // Replaced by m_drawingArea
     Gtk::DrawingArea m_drawingArea; // Used for custom drawing the game board
-    GameGrid m_gameGrid;   // The logical game grid
-    Pathfinder m_pathfinder;
-    Solver m_solver;
+    colorlines::Board<9, 9> m_gameGrid;   // The logical game grid (fixed 9x9 board)
+    colorlines::Pathfinder<9, 9> m_pathfinder;
+    colorlines::MoveJournal<9, 9> m_journal; // Records each turn so it can be undone
+    colorlines::TurnResolver<GameRules, 9, 9> m_turnResolver; // Plays turns through m_journal
+    colorlines::Snapshot<colorlines::Board<9, 9>> m_positionSnapshot; // See getPositionSnapshot()
 
     bool m_ballSelected;
     int m_selectedRow, m_selectedCol;
@@ -40,6 +55,7 @@ protected:
     Gtk::Label m_gameOverLabel;
     bool m_gameOver;
     Gtk::Button m_newGameButton; // New Game button
+    Gtk::Button m_undoButton; // Undo button, reverts the last turn
 };
 
 #endif //MAINWINDOW_H
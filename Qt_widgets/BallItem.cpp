@@ -1,14 +1,14 @@
 #include "BallItem.h"
 #include <QPainter>
 
-BallItem::BallItem(Ball* ball, const QPixmap& pixmap, QGraphicsItem* parent)
-    : QGraphicsObject(parent), m_ball(ball), m_pixmap(pixmap) {
-    // Store the associated Ball object and the pixmap
+BallItem::BallItem(int ballId, const QPixmap& pixmap, QGraphicsItem* parent)
+    : QGraphicsObject(parent), m_ballId(ballId), m_pixmap(pixmap) {
+    // Store the associated ball id and the pixmap
     // Position will be set via setPos() by MainWindow
 }
 
-Ball* BallItem::getBall() const {
-    return m_ball;
+int BallItem::getBallId() const {
+    return m_ballId;
 }
 
 QRectF BallItem::boundingRect() const {
@@ -5,16 +5,15 @@
 #include <QString>
 #include <QPixmap>
 #include <QPainter> // Needed for paint method
-#include "Ball.h"
 
 class BallItem : public QGraphicsObject { // Inherits QObject and QGraphicsItem
     Q_OBJECT
     // Q_PROPERTY(QPointF pos READ pos WRITE setPos) // "pos" is an existing property of QGraphicsItem
 
 public:
-    BallItem(Ball* ball, const QPixmap& pixmap, QGraphicsItem* parent = nullptr);
+    BallItem(int ballId, const QPixmap& pixmap, QGraphicsItem* parent = nullptr);
 
-    Ball* getBall() const;
+    int getBallId() const; // Id of the grid ball this item shows
 
     // Required virtual functions for QGraphicsItem (already in QGraphicsObject's base)
     QRectF boundingRect() const override;
@@ -22,7 +21,7 @@ public:
 
 
 private:
-    Ball* m_ball; // Pointer to the logical ball object, BallItem does not own it
+    int m_ballId; // Id of the logical ball; the grid owns the ball data
     QPixmap m_pixmap; // Store the pixmap for painting
 
     static const int DEFAULT_CELL_SIZE = 50; // Fallback if not scaled, or use actual
@@ -1,118 +1,80 @@
 #include "Grid.h"
-#include <QRandomGenerator> // For random number generation
+#include <QRandomGenerator> // Seeds the core board's spawn RNG
 #include <QDebug> // For potential debugging
 
-Grid::Grid() {
-    m_availableColors << "red" << "blue" << "green" << "yellow" << "purple" << "pink" << "brown" << "turquoise";
+template <int Size>
+BasicGrid<Size>::BasicGrid() {
+    m_board.setSpawnColorCount(COLOR_COUNT);
+    m_board.setRngState(QRandomGenerator::global()->generate64());
     initializeGrid();
 }
 
-Grid::~Grid() {
-    // Clean up any remaining Ball objects
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            if (m_gridData[i][j] != nullptr) {
-                delete m_gridData[i][j];
-                m_gridData[i][j] = nullptr;
-            }
-        }
-    }
-}
-
-void Grid::initializeGrid() {
-    m_gridData.resize(GRID_SIZE);
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        m_gridData[i].resize(GRID_SIZE);
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            m_gridData[i][j] = nullptr;
-        }
+template <int Size>
+void BasicGrid<Size>::initializeGrid() {
+    m_board.reset();
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        m_ballIds[cell] = 0;
     }
     m_currentMaxBallId = 0; // Reset ball ID counter if re-initializing
 }
 
-Ball* Grid::getBallAt(int x, int y) const {
-    if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-        return m_gridData[x][y];
-    }
-    return nullptr; // Out of bounds
-}
-
-bool Grid::isCellEmpty(int x, int y) const {
-    if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-        return m_gridData[x][y] == nullptr;
-    }
-    return false; // Out of bounds is not "empty" in a usable sense
-}
-
-bool Grid::placeBall(int x, int y, Ball* ball) {
-    if (ball == nullptr) return false; // Cannot place a null ball
+template <int Size>
+bool BasicGrid<Size>::placeBall(int x, int y, const Ball& ball) {
+    if (ball.isEmpty()) return false; // Cannot place an empty ball
     if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-        if (isCellEmpty(x, y)) {
-            m_gridData[x][y] = ball;
+        if (m_board.isCellEmpty(y, x)) {
+            m_board.placeBall(y, x, ball.getColor());
+            m_ballIds[m_board.cellIndex(y, x)] = static_cast<uint16_t>(ball.getId()); // Ids come from nextBallId()
             return true;
         }
     }
     return false; // Cell not empty or out of bounds
 }
 
-Ball* Grid::removeBall(int x, int y) {
+template <int Size>
+Ball BasicGrid<Size>::removeBall(int x, int y) {
     if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-        Ball* ball = m_gridData[x][y];
-        m_gridData[x][y] = nullptr;
-        return ball; // Caller is responsible for deleting this ball object if necessary
+        Ball ball = ballAt(x, y);
+        if (!ball.isEmpty()) {
+            m_board.removeBall(y, x);
+            m_ballIds[m_board.cellIndex(y, x)] = 0;
+        }
+        return ball;
     }
-    return nullptr; // Out of bounds or cell was empty
+    return Ball(); // Out of bounds or cell was empty
 }
 
-QList<QPoint> Grid::getEmptyCells() const {
+template <int Size>
+QList<QPoint> BasicGrid<Size>::getEmptyCells() const {
     QList<QPoint> emptyCells;
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            if (m_gridData[i][j] == nullptr) {
-                emptyCells.append(QPoint(i, j));
-            }
-        }
+    emptyCells.reserve(m_board.getEmptyCount());
+    for (int slot = 0; slot < m_board.getEmptyCount(); ++slot) {
+        int cell = m_board.getEmptyCell(slot);
+        emptyCells.append(QPoint(cell % GRID_SIZE, cell / GRID_SIZE));
     }
     return emptyCells;
 }
 
-QString Grid::getRandomColor() const {
-    if (m_availableColors.isEmpty()) {
-        return QString(); // Should not happen if initialized correctly
-    }
-    int randomIndex = QRandomGenerator::global()->bounded(m_availableColors.size());
-    return m_availableColors[randomIndex];
+template <int Size>
+BallColor BasicGrid<Size>::getRandomColor() {
+    return m_board.randomColor();
 }
 
-QPoint Grid::placeRandomBall(const QString& color) {
-    QList<QPoint> emptyCells = getEmptyCells();
-    if (emptyCells.isEmpty()) {
-        return QPoint(-1, -1); // No space to place a ball
+template <int Size>
+QPoint BasicGrid<Size>::placeRandomBall(BallColor color) {
+    if (color == BallColor::EMPTY || m_board.isFull()) {
+        return QPoint(-1, -1); // Nothing to place or no space to place it
     }
 
-    int randomIndex = QRandomGenerator::global()->bounded(emptyCells.size());
-    QPoint randomCell = emptyCells[randomIndex];
-
-    m_currentMaxBallId++;
-    Ball* newBall = new Ball(color, m_currentMaxBallId);
-    if (placeBall(randomCell.x(), randomCell.y(), newBall)) {
-        return randomCell;
-    }
-    // Should not happen if logic is correct (empty cell was chosen)
-    // but as a fallback:
-    delete newBall; // Clean up if placement failed unexpectedly
-    m_currentMaxBallId--; // Roll back ID
-    return QPoint(-1,-1);
+    std::pair<int, int> placed = m_board.placeRandomBall(color);
+    m_ballIds[m_board.cellIndex(placed.first, placed.second)] = nextBallId();
+    return QPoint(placed.second, placed.first);
 }
 
-void Grid::placeInitialBalls(int count) {
+template <int Size>
+void BasicGrid<Size>::placeInitialBalls(int count) {
     for (int i = 0; i < count; ++i) {
-        QString color = getRandomColor();
-        if (color.isEmpty()) { // Should not happen
-            qWarning() << "Could not get random color.";
-            continue;
-        }
-        QPoint placedPos = placeRandomBall(color);
+        QPoint placedPos = placeRandomBall(getRandomColor());
         if (placedPos.x() < 0) { // Check for invalid point
             // Grid might be full, stop trying
             qWarning() << "Could not place initial ball, grid might be full.";
@@ -121,22 +83,33 @@ void Grid::placeInitialBalls(int count) {
     }
 }
 
-int Grid::getGridSize() const {
+template <int Size>
+void BasicGrid<Size>::unpack(const colorlines::PackedBoard<Size, Size>& packed) {
+    packed.unpack(m_board);
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        m_ballIds[cell] = m_board.getColor(cell) == BallColor::EMPTY ? 0 : nextBallId();
+    }
+}
+
+template <int Size>
+int BasicGrid<Size>::getGridSize() const {
     return GRID_SIZE;
 }
 
-int Grid::getBallCount() const {
-    int count = 0;
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            if (m_gridData[i][j] != nullptr) {
-                count++;
-            }
-        }
-    }
-    return count;
+template <int Size>
+int BasicGrid<Size>::getBallCount() const {
+    return CELL_COUNT - m_board.getEmptyCount();
 }
 
-QStringList Grid::getAvailableColors() const {
-    return m_availableColors;
+template <int Size>
+QList<BallColor> BasicGrid<Size>::getAvailableColors() const {
+    QList<BallColor> colors;
+    for (int i = 1; i <= m_board.getSpawnColorCount(); ++i) {
+        colors.append(static_cast<BallColor>(i));
+    }
+    return colors;
 }
+
+template class BasicGrid<7>;
+template class BasicGrid<9>;
+template class BasicGrid<11>;
@@ -3,33 +3,134 @@
 
 #include <QVector>
 #include <QPoint>
-#include <QStringList>
-#include "Ball.h" // Assuming Ball.h is in the same directory
+#include <QList>
+#include <cstdint>
+#include "GameGrid.h" // colorlines::Board from the shared core library
+#include "PackedBoard.h"
+#include "TurnResolver.h" // Whole-turn resolution shared with the GTK frontend
 
-class Grid {
+using colorlines::Ball;
+using colorlines::BallColor;
+using colorlines::BALL_COLOR_COUNT;
+using colorlines::ballColorName;
+
+// Square grid whose side is a compile-time constant, so bounds checks and loop
+// trip counts fold to constants. BasicGrid<7>, BasicGrid<9> and BasicGrid<11> are
+// instantiated in Grid.cpp; the game uses the classic 9x9 board (Grid).
+//
+// Colours, the empty-cell index, the Zobrist hash and the spawn RNG live in a core
+// colorlines::Board (Qt cell (x, y) is board row y, column x). The grid only adds the
+// per-cell ball ids that BallItem uses to track individual balls across moves.
+// Ball values handed out by the grid are lightweight copies, not owned objects.
+template <int Size>
+class BasicGrid {
 public:
-    static const int GRID_SIZE = 9;
+    static constexpr int GRID_SIZE = Size;
 
-    Grid();
-    ~Grid(); // Destructor to clean up Ball objects
+    BasicGrid();
 
     void initializeGrid();
-    Ball* getBallAt(int x, int y) const;
-    bool isCellEmpty(int x, int y) const;
-    bool placeBall(int x, int y, Ball* ball);
-    Ball* removeBall(int x, int y);
+    // Returns an empty Ball for empty or out-of-bounds cells.
+    Ball getBallAt(int x, int y) const {
+        if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
+            return ballAt(x, y);
+        }
+        return Ball(); // Out of bounds
+    }
+    // Unchecked access for callers that have already bounded x and y.
+    Ball ballAt(int x, int y) const {
+        int cell = m_board.cellIndex(y, x);
+        return Ball(m_board.getColor(cell), m_ballIds[cell]); // Empty ball (id 0) for empty cells
+    }
+    // Unchecked colour lookup, read from the core board's colour masks.
+    BallColor colorAt(int x, int y) const { return m_board.getColor(m_board.cellIndex(y, x)); }
+    bool isCellEmpty(int x, int y) const {
+        if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
+            return m_board.isCellEmpty(y, x);
+        }
+        return false; // Out of bounds is not "empty" in a usable sense
+    }
+    bool placeBall(int x, int y, const Ball& ball);
+    Ball removeBall(int x, int y); // Returns the removed ball, or an empty Ball
     QList<QPoint> getEmptyCells() const;
-    QPoint placeRandomBall(const QString& color); // Returns QPoint of placement or (-1,-1)
+    int getEmptyCellCount() const { return m_board.getEmptyCount(); } // O(1)
+    bool isFull() const { return m_board.isFull(); }
+    QPoint placeRandomBall(BallColor color); // Returns QPoint of placement or (-1,-1)
     void placeInitialBalls(int count);
-    QString getRandomColor() const;
+    BallColor getRandomColor();
     int getGridSize() const;
     int getBallCount() const; // Useful for game logic/scoring
-    QStringList getAvailableColors() const; // Getter for available colors
+    QList<BallColor> getAvailableColors() const; // Colours that getRandomColor() can return
+
+    // Zobrist hash of the ball colours on the grid, maintained by the core board.
+    // XOR in colorlines::Zobrist::upcomingKey() values to also cover the upcoming-ball queue.
+    quint64 getHash() const { return m_board.getHash(); }
+
+    // 4-bit packed encoding of the ball colours, shared with the GTK frontend's boards.
+    colorlines::PackedBoard<Size, Size> pack() const { return colorlines::PackedBoard<Size, Size>(m_board); }
+    // Replaces the grid contents with a packed position; balls get fresh ids.
+    void unpack(const colorlines::PackedBoard<Size, Size>& packed);
+
+    // Plays a whole turn under 'Rules' (see colorlines::TurnResolver): moves the ball at
+    // 'from' to 'to', clears lines, and spawns 'spawnColors' if the move cleared nothing.
+    // Ball ids follow along: the moved ball keeps its id, spawned balls get new ones.
+    template <class Rules>
+    colorlines::TurnResult playTurn(QPoint from, QPoint to, const QList<BallColor>& spawnColors);
+
+    // The underlying core board, for engine code shared with the GTK frontend.
+    const colorlines::Board<Size, Size>& board() const { return m_board; }
 
 private:
-    QVector<QVector<Ball*>> m_gridData;
-    int m_currentMaxBallId = 0; // To generate unique IDs for balls
-    QStringList m_availableColors;
+    static constexpr int CELL_COUNT = Size * Size;
+    static constexpr int COLOR_COUNT = 8; // RED through TURQUOISE
+
+    colorlines::Board<Size, Size> m_board;
+    // Indexed like the board (y * GRID_SIZE + x); 0 for empty cells. 16 bits keep the
+    // array at 2 * CELL_COUNT bytes next to the board.
+    uint16_t m_ballIds[CELL_COUNT];
+
+    uint16_t m_currentMaxBallId = 0; // To generate unique IDs for balls
+
+    // Next ball id, wrapping past 65535 back to 1 (0 means no ball). A ball would have
+    // to stay on the board through 65535 later spawns to share its id with a new one.
+    uint16_t nextBallId() {
+        if (++m_currentMaxBallId == 0) m_currentMaxBallId = 1;
+        return m_currentMaxBallId;
+    }
 };
 
+template <int Size>
+template <class Rules>
+colorlines::TurnResult BasicGrid<Size>::playTurn(QPoint from, QPoint to, const QList<BallColor>& spawnColors) {
+    BallColor colors[colorlines::TurnResult::MAX_SPAWNS];
+    int spawnCount = 0;
+    for (BallColor color : spawnColors) {
+        if (spawnCount == colorlines::TurnResult::MAX_SPAWNS) break;
+        colors[spawnCount++] = color;
+    }
+
+    int fromCell = m_board.cellIndex(from.y(), from.x());
+    int toCell = m_board.cellIndex(to.y(), to.x());
+    uint16_t movedId = m_ballIds[fromCell];
+    colorlines::TurnResolver<Rules, Size, Size> resolver(&m_board);
+    colorlines::TurnResult result = resolver.playTurn(fromCell, toCell, spawnCount, colors);
+
+    m_ballIds[fromCell] = 0;
+    m_ballIds[toCell] = movedId;
+    for (int i = 0; i < result.spawnCount; ++i) {
+        m_ballIds[result.spawnCells[i]] = nextBallId();
+    }
+    colorlines::Bitboard cleared = result.cleared | result.spawnCleared;
+    while (cleared.any()) {
+        m_ballIds[cleared.popLowestBit()] = 0;
+    }
+    return result;
+}
+
+extern template class BasicGrid<7>;
+extern template class BasicGrid<9>;
+extern template class BasicGrid<11>;
+
+typedef BasicGrid<9> Grid;
+
 #endif // GRID_H
@@ -1,17 +1,52 @@
 #include "Pathfinder.h"
 #include "Grid.h" // For Grid::isCellEmpty, Grid::GRID_SIZE
-#include "qtpoint_hash.h" // For qHash(QPoint)
-#include <QSet>
-#include <QVector>
 #include <QPoint> // Ensure QPoint is fully defined (though likely pulled by other headers)
-#include <QtCore/qhashfunctions.h> // For qHash generic implementations
 #include <QtGlobal> // For Q_ASSERT and other Qt globals
-#include <algorithm> // For std::sort and std::find_if
+#include <algorithm> // For std::push_heap, std::pop_heap and std::fill
+#include <climits>   // For INT_MAX
 #include <cmath>     // For std::abs
 
+// The grid's core board, checking the grid before it is dereferenced
+static const colorlines::Board<Grid::GRID_SIZE, Grid::GRID_SIZE>* boardOf(const Grid* grid) {
+    Q_ASSERT(grid != nullptr); // A pathfinder needs a grid
+    return &grid->board();
+}
+
 // Pathfinder Constructor
-Pathfinder::Pathfinder(const Grid* grid) : m_grid(grid) {
-    Q_ASSERT(m_grid != nullptr); // Ensure grid is not null
+Pathfinder::Pathfinder(const Grid* grid) : m_grid(grid), m_reach(boardOf(grid)) {
+    clearCache();
+}
+
+void Pathfinder::clearCache() {
+    std::fill(m_cacheBuckets, m_cacheBuckets + PATH_CACHE_BUCKETS, -1);
+    for (CacheEntry& entry : m_cache) {
+        entry.path = QList<QPoint>(); // Release the stored lists
+    }
+    m_cacheSize = 0;
+    m_newest = -1;
+    m_oldest = -1;
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
+
+int Pathfinder::cacheBucket(quint64 gridHash, int start, int end) const {
+    // Zobrist hashes are already well mixed; fold in the cells and take the top bits
+    quint64 key = (gridHash ^ (quint64(start * CELL_COUNT + end) * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL;
+    return static_cast<int>(key >> 32) & (PATH_CACHE_BUCKETS - 1);
+}
+
+void Pathfinder::unlinkRecency(int entry) {
+    CacheEntry& e = m_cache[entry];
+    if (e.newer != -1) m_cache[e.newer].older = e.older; else m_newest = e.older;
+    if (e.older != -1) m_cache[e.older].newer = e.newer; else m_oldest = e.newer;
+}
+
+void Pathfinder::linkNewest(int entry) {
+    CacheEntry& e = m_cache[entry];
+    e.newer = -1;
+    e.older = m_newest;
+    if (m_newest != -1) m_cache[m_newest].newer = entry; else m_oldest = entry;
+    m_newest = entry;
 }
 
 // Heuristic Calculation (Manhattan Distance)
@@ -20,20 +55,27 @@ int Pathfinder::calculateHeuristic(const QPoint& a, const QPoint& b) const {
 }
 
 // Path Reconstruction
-QList<QPoint> Pathfinder::reconstructPath(Pathfinding::Node* targetNode) const {
+QList<QPoint> Pathfinder::reconstructPath(int targetCell) const {
+    int length = 0;
+    for (int cell = targetCell; cell != -1; cell = m_parent[cell]) {
+        ++length;
+    }
     QList<QPoint> path;
-    Pathfinding::Node* currentNode = targetNode;
-    while (currentNode != nullptr) {
-        path.prepend(currentNode->position); // Add to the beginning to reverse the path
-        currentNode = currentNode->parent;
+    path.reserve(length);
+    for (int i = 0; i < length; ++i) {
+        path.append(QPoint());
+    }
+    int index = length;
+    for (int cell = targetCell; cell != -1; cell = m_parent[cell]) {
+        path[--index] = QPoint(cell % Grid::GRID_SIZE, cell / Grid::GRID_SIZE); // Filled back to front
     }
     return path;
 }
 
-// A* Pathfinding Algorithm
+// Cached lookup in front of the search
 QList<QPoint> Pathfinder::findPath(const QPoint& start, const QPoint& end) {
-    if (!m_grid || start == end) {
-        return QList<QPoint>(); // No grid or start is end
+    if (start == end) {
+        return QList<QPoint>(); // Start is end
     }
 
     // Check if start or end are outside grid boundaries
@@ -42,6 +84,50 @@ QList<QPoint> Pathfinder::findPath(const QPoint& start, const QPoint& end) {
         return QList<QPoint>(); // Start or end out of bounds
     }
 
+    quint64 gridHash = m_grid->getHash();
+    int startCell = start.y() * Grid::GRID_SIZE + start.x();
+    int endCell = end.y() * Grid::GRID_SIZE + end.x();
+    int bucket = cacheBucket(gridHash, startCell, endCell);
+    for (int entry = m_cacheBuckets[bucket]; entry != -1; entry = m_cache[entry].bucketNext) {
+        const CacheEntry& e = m_cache[entry];
+        if (e.gridHash == gridHash && e.start == startCell && e.end == endCell) {
+            ++m_cacheHits;
+            unlinkRecency(entry);
+            linkNewest(entry);
+            return e.path;
+        }
+    }
+    ++m_cacheMisses;
+
+    QList<QPoint> path = searchPath(start, end);
+
+    // Take a free entry, or evict the least recently used one from its bucket chain
+    int entry;
+    if (m_cacheSize < PATH_CACHE_CAPACITY) {
+        entry = m_cacheSize++;
+    } else {
+        entry = m_oldest;
+        unlinkRecency(entry);
+        const CacheEntry& old = m_cache[entry];
+        int* link = &m_cacheBuckets[cacheBucket(old.gridHash, old.start, old.end)];
+        while (*link != entry) {
+            link = &m_cache[*link].bucketNext;
+        }
+        *link = old.bucketNext;
+    }
+    CacheEntry& e = m_cache[entry];
+    e.gridHash = gridHash;
+    e.start = startCell;
+    e.end = endCell;
+    e.path = path; // Implicitly shared with the returned list
+    e.bucketNext = m_cacheBuckets[bucket];
+    m_cacheBuckets[bucket] = entry;
+    linkNewest(entry);
+    return path;
+}
+
+// A* Pathfinding Algorithm
+QList<QPoint> Pathfinder::searchPath(const QPoint& start, const QPoint& end) {
     // The target cell MUST be empty for a valid path in this game.
     // (Unlike some A* where target might be an enemy, here it's a destination cell)
     if (!m_grid->isCellEmpty(end.x(), end.y())) {
@@ -61,41 +147,48 @@ QList<QPoint> Pathfinder::findPath(const QPoint& start, const QPoint& end) {
         }
     }
 
+    // The end cell is empty here, so it is reachable only if it lies in one of the empty
+    // regions next to the start (the core pathfinder's region lookup). Saves a full search
+    // for every unreachable target.
+    int startCell = start.y() * Grid::GRID_SIZE + start.x();
+    int endCell = end.y() * Grid::GRID_SIZE + end.x();
+    if (!m_reach.getReachableCells(start.y(), start.x()).test(endCell)) {
+        return QList<QPoint>();
+    }
 
-    QVector<Pathfinding::Node*> openList;
-    QSet<QPoint> closedList; // Stores QPoint for efficient lookup
-    QList<Pathfinding::Node*> allNodes; // To manage memory deletion
-
-    Pathfinding::Node* startNode = new Pathfinding::Node(start, 0, calculateHeuristic(start, end), nullptr);
-    allNodes.append(startNode);
-    openList.append(startNode);
+    std::fill(m_gCost, m_gCost + CELL_COUNT, INT_MAX);
+    std::fill(m_closed, m_closed + CELL_COUNT, false);
+    Pathfinding::CompareEntry compare;
+    int openSize = 0;
 
-    int D = 1; // Cost for adjacent (non-diagonal) movement
+    m_gCost[startCell] = 0;
+    m_parent[startCell] = -1;
+    int startH = calculateHeuristic(start, end);
+    m_open[openSize++] = {startH, startH, startCell};
 
-    while (!openList.isEmpty()) {
-        // Find node with the lowest fCost in openList
-        // Sort openList to bring the node with the smallest fCost to the end for easy pop_back
-        // Using custom lambda for sort or std::sort with a custom comparator struct
-        std::sort(openList.begin(), openList.end(), [](const Pathfinding::Node* a, const Pathfinding::Node* b){
-            return Pathfinding::CompareNode()(a,b); // Uses the > operator for min-heap like behavior (smallest is last)
-        });
+    const int D = 1; // Cost for adjacent (non-diagonal) movement
 
-        Pathfinding::Node* currentNode = openList.takeLast(); // Smallest fCost node
+    while (openSize > 0) {
+        // Pop the node with the lowest fCost
+        std::pop_heap(m_open, m_open + openSize, compare);
+        int currentCell = m_open[--openSize].cell;
+        if (m_closed[currentCell]) {
+            continue; // Stale entry: the cell was already expanded through a cheaper path
+        }
 
-        if (currentNode->position == end) {
-            QList<QPoint> path = reconstructPath(currentNode);
-            qDeleteAll(allNodes); // Clean up all allocated nodes
-            return path;
+        if (currentCell == endCell) {
+            return reconstructPath(currentCell);
         }
 
-        closedList.insert(currentNode->position);
+        m_closed[currentCell] = true;
 
         // Explore neighbors (Up, Down, Left, Right)
+        QPoint current(currentCell % Grid::GRID_SIZE, currentCell / Grid::GRID_SIZE);
         QPoint neighbors[4] = {
-            QPoint(currentNode->position.x(), currentNode->position.y() - 1), // Up
-            QPoint(currentNode->position.x(), currentNode->position.y() + 1), // Down
-            QPoint(currentNode->position.x() - 1, currentNode->position.y()), // Left
-            QPoint(currentNode->position.x() + 1, currentNode->position.y())  // Right
+            QPoint(current.x(), current.y() - 1), // Up
+            QPoint(current.x(), current.y() + 1), // Down
+            QPoint(current.x() - 1, current.y()), // Left
+            QPoint(current.x() + 1, current.y())  // Right
         };
 
         for (const QPoint& neighborPos : neighbors) {
@@ -105,48 +198,29 @@ QList<QPoint> Pathfinder::findPath(const QPoint& start, const QPoint& end) {
                 continue;
             }
 
+            int neighborCell = neighborPos.y() * Grid::GRID_SIZE + neighborPos.x();
             // Check if already evaluated
-            if (closedList.contains(neighborPos)) {
+            if (m_closed[neighborCell]) {
                 continue;
             }
 
-            // Check if walkable (empty cell)
-            // The target cell (end) must be empty. All intermediate cells must also be empty.
-            if (!m_grid->isCellEmpty(neighborPos.x(), neighborPos.y()) && neighborPos != end) {
-                 continue;
+            // Check if walkable (empty cell). The target cell (end) was checked to be empty
+            // at the start of the function; all intermediate cells must also be empty.
+            if (!m_grid->isCellEmpty(neighborPos.x(), neighborPos.y())) {
+                continue;
             }
-            // If the neighbor IS the end point, it must be empty (checked at the start of the function).
-            // So no special handling for `neighborPos == end` regarding walkability is needed here,
-            // as `isCellEmpty(end.x(), end.y())` must be true.
-
-            int tentativeGCost = currentNode->gCost + D; // D is 1 for cardinal moves
-
-            Pathfinding::Node* neighborNode = nullptr;
-            auto it = std::find_if(openList.begin(), openList.end(), [&](Pathfinding::Node* node){
-                return node->position == neighborPos;
-            });
-
-            if (it != openList.end()) { // If neighbor is in openList
-                neighborNode = *it;
-                if (tentativeGCost < neighborNode->gCost) {
-                    neighborNode->gCost = tentativeGCost;
-                    neighborNode->parent = currentNode;
-                    // No need to update hCost as it's fixed for the node position
-                    // openList will be re-sorted
-                }
-            } else { // Neighbor not in openList
-                neighborNode = new Pathfinding::Node(
-                    neighborPos,
-                    tentativeGCost,
-                    calculateHeuristic(neighborPos, end),
-                    currentNode
-                );
-                allNodes.append(neighborNode);
-                openList.append(neighborNode);
+
+            int tentativeGCost = m_gCost[currentCell] + D;
+            if (tentativeGCost < m_gCost[neighborCell]) {
+                m_gCost[neighborCell] = tentativeGCost;
+                m_parent[neighborCell] = currentCell;
+                int hCost = calculateHeuristic(neighborPos, end);
+                Q_ASSERT(openSize < OPEN_CAPACITY);
+                m_open[openSize++] = {tentativeGCost + hCost, hCost, neighborCell};
+                std::push_heap(m_open, m_open + openSize, compare);
             }
         }
     }
 
-    qDeleteAll(allNodes); // Clean up if no path found
     return QList<QPoint>(); // No path found
 }
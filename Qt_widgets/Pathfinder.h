@@ -4,43 +4,30 @@
 #include <QVector>
 #include <QPoint>
 #include <QList> // For the path result
-#include <QSet>  // For the closed list
 
-#include <QtCore/qhashfunctions.h> // For qHash generic implementations (needed for the custom qHash)
-#include <QtGlobal>                // For Q_ASSERT and other Qt globals (if used in qHash)
+#include <QtGlobal> // For quint64
 
-// Forward declaration
-class Grid;
+#include "Grid.h" // Grid is a typedef of BasicGrid<9>, so it cannot be forward-declared
+// The core pathfinder; spelled out because this header has the same file name
+#include "../core/src/Pathfinder.h"
 
-// qHash for QPoint is now in "qtpoint_hash.h"
+namespace Pathfinding { // Encapsulate search types to avoid global namespace pollution
 
-namespace Pathfinding { // Encapsulate Node to avoid global namespace pollution
-
-struct Node {
-    QPoint position;
-    int gCost;      // Cost from start to this node
-    int hCost;      // Heuristic cost from this node to end
-    Node* parent;   // Pointer to the parent node for path reconstruction
-
-    Node(QPoint pos, int g, int h, Node* p)
-        : position(pos), gCost(g), hCost(h), parent(p) {}
-
-    int fCost() const { return gCost + hCost; }
-
-    // For priority queue if std::priority_queue is used with custom objects
-    // bool operator>(const Node& other) const {
-    //     return fCost() > other.fCost(); // Min-heap behavior
-    // }
+// Open-list entry: a cell and the costs it was queued with. Stale entries (the cell was
+// reached more cheaply or closed since) are skipped when popped.
+struct OpenEntry {
+    int fCost;
+    int hCost;
+    int cell; // y * GRID_SIZE + x
 };
 
-// Custom comparator for std::sort or a min-heap if not using std::priority_queue directly
-// with operator>
-struct CompareNode {
-    bool operator()(const Node* a, const Node* b) const {
-        if (a->fCost() == b->fCost()) {
-            return a->hCost > b->hCost; // Tie-breaking: prefer smaller hCost
+// Heap order for std::push_heap/pop_heap: lowest fCost on top, ties to the smaller hCost
+struct CompareEntry {
+    bool operator()(const OpenEntry& a, const OpenEntry& b) const {
+        if (a.fCost == b.fCost) {
+            return a.hCost > b.hCost;
         }
-        return a->fCost() > b->fCost(); // Min-heap behavior (lowest fCost has higher priority)
+        return a.fCost > b.fCost;
     }
 };
 
@@ -49,19 +36,69 @@ struct CompareNode {
 
 class Pathfinder {
 public:
-    Pathfinder(const Grid* grid); // Constructor takes a const pointer to the grid
+    Pathfinder(const Grid* grid); // Constructor takes a const pointer to the grid, which must not be null
 
     // Finds a path from start to end. Returns an empty list if no path is found.
+    // Results are cached per (grid hash, start, end), so repeating a query on an unchanged
+    // grid (hover previews, re-clicks, analysis) is one hash probe and a list copy.
     QList<QPoint> findPath(const QPoint& start, const QPoint& end);
 
+    // Path cache statistics since construction (or the last clearCache()).
+    int getCacheHits() const { return m_cacheHits; }
+    int getCacheMisses() const { return m_cacheMisses; }
+    void clearCache();
+
+    static const int PATH_CACHE_CAPACITY = 256; // Least recently used paths are evicted beyond this
+
 private:
+    // Uncached search for in-bounds start != end. Unreachable targets are rejected by a
+    // region lookup before any search runs; then A* over fixed per-cell arrays and a
+    // binary heap, where only the returned list allocates.
+    QList<QPoint> searchPath(const QPoint& start, const QPoint& end);
+
     const Grid* m_grid; // Pointer to the grid, Pathfinder does not own it
+    colorlines::Pathfinder<Grid::GRID_SIZE, Grid::GRID_SIZE> m_reach; // Region-based reachability on the core board
 
     // Calculates the heuristic (Manhattan distance) between two points
     int calculateHeuristic(const QPoint& a, const QPoint& b) const;
 
-    // Reconstructs the path from the target node back to the start
-    QList<QPoint> reconstructPath(Pathfinding::Node* targetNode) const;
+    // Reconstructs the path from the target cell back to the start through m_parent
+    QList<QPoint> reconstructPath(int targetCell) const;
+
+    static const int CELL_COUNT = Grid::GRID_SIZE * Grid::GRID_SIZE;
+    // Each cell is queued at most once per improvement from one of its 4 neighbours
+    static const int OPEN_CAPACITY = 4 * CELL_COUNT;
+
+    // Search state, reused by every findPath() call
+    int m_gCost[CELL_COUNT];  // Cost from start; INT_MAX when not reached yet
+    int m_parent[CELL_COUNT]; // Previous cell on the best known path; -1 for the start
+    bool m_closed[CELL_COUNT];
+    Pathfinding::OpenEntry m_open[OPEN_CAPACITY]; // Binary heap, see CompareEntry
+
+    // Path cache: entries keyed by the grid's Zobrist hash and both cells, so a changed grid
+    // never matches an old entry. Buckets chain entries by index; a doubly linked list by
+    // index keeps them in recency order. All storage is fixed, so lookups do not allocate.
+    static const int PATH_CACHE_BUCKETS = 2 * PATH_CACHE_CAPACITY; // Power of two
+    struct CacheEntry {
+        quint64 gridHash;
+        int start;        // Cell indices (y * GRID_SIZE + x)
+        int end;
+        QList<QPoint> path;
+        int bucketNext;   // Next entry in the same bucket, or -1
+        int newer;        // Neighbours in recency order, or -1
+        int older;
+    };
+    int cacheBucket(quint64 gridHash, int start, int end) const;
+    void unlinkRecency(int entry);
+    void linkNewest(int entry);
+
+    CacheEntry m_cache[PATH_CACHE_CAPACITY];
+    int m_cacheBuckets[PATH_CACHE_BUCKETS]; // First entry of each bucket, or -1
+    int m_cacheSize = 0;
+    int m_newest = -1;
+    int m_oldest = -1;
+    int m_cacheHits = 0;
+    int m_cacheMisses = 0;
 };
 
 #endif // PATHFINDER_H
@@ -6,7 +6,11 @@ QT += widgets gui
 CONFIG += c++17
 TEMPLATE = app
 TARGET = QtLines
-INCLUDEPATH += .
+INCLUDEPATH += . $$PWD/../core/src
+
+# Game engine shared with the GTK frontend; build it first with `make -C ../core`
+LIBS += -L$$PWD/../core -lcolorlines
+PRE_TARGETDEPS += $$PWD/../core/libcolorlines.a
 
 # You can make your code fail to compile if you use deprecated APIs.
 # In order to do so, uncomment the following line.
@@ -18,19 +22,14 @@ INCLUDEPATH += .
 # Input
 SOURCES += main.cpp \
     mainwindow.cpp \
-    Ball.cpp \
     Grid.cpp \
     BallItem.cpp \
-    Solver.cpp \
     Pathfinder.cpp
 
 HEADERS += \
     mainwindow.h \
-    Ball.h \
     Grid.h \
     BallItem.h \
-    Solver.h \
-    Pathfinder.h \
-    qtpoint_hash.h
+    Pathfinder.h
 
 RESOURCES += resources.qrc
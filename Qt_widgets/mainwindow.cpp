@@ -13,14 +13,12 @@
 #include <QEvent>
 #include <QGraphicsSceneMouseEvent>
 #include <QMessageBox> // For QMessageBox
-#include "qtpoint_hash.h" // For qHash(QPoint)
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       m_scene(new QGraphicsScene(this)),
       m_grid(),
       m_pathfinder(&m_grid),
-      m_solver(&m_grid), // Initialize m_solver with address of m_grid
       m_selectedBallItem(nullptr),
       m_ballAnimation(new QPropertyAnimation(this)) // Parent animation to this for auto-cleanup
       // m_score is initialized to 0 by default member initialization in .h
@@ -57,7 +55,7 @@ MainWindow::~MainWindow()
     // m_scene is child of MainWindow, Qt handles its deletion.
     // m_ballPixmaps, m_grid, m_pathfinder are members, destructors called.
     // m_ballAnimation is child of MainWindow, Qt handles its deletion.
-    // m_selectedBallItem is QPointer, handles itself.
+    // m_selectedBallItem is owned by m_scene.
 }
 
 void MainWindow::setupUI() {
@@ -96,24 +94,21 @@ void MainWindow::setupUI() {
 
 
 void MainWindow::loadBallPixmaps() {
-    QStringList colors = m_grid.getAvailableColors();
-    if (colors.isEmpty()) {
-         colors << "red" << "blue" << "green" << "yellow" << "purple" << "pink" << "brown" << "turquoise";
-    }
-
-    for (const QString& color : colors) {
-        QString path = QString(":/images/%1_ball.png").arg(color);
+    // Resource files are named after the colour, e.g. ":/images/red_ball.png"
+    for (int i = 1; i < BALL_COLOR_COUNT; ++i) {
+        QString name = ballColorName(static_cast<BallColor>(i));
+        QString path = QString(":/images/%1_ball.png").arg(name);
         QPixmap pixmap(path);
         if (pixmap.isNull()) {
-            qWarning() << "Failed to load ball pixmap for color:" << color << "from path:" << path;
+            qWarning() << "Failed to load ball pixmap for color:" << name << "from path:" << path;
         } else {
-            m_ballPixmaps[color] = pixmap.scaled(CELL_SIZE, CELL_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            m_ballPixmaps[i] = pixmap.scaled(CELL_SIZE, CELL_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         }
     }
 }
 
 void MainWindow::drawGrid() {
-    m_scene->clear(); // This also deletes BallItem objects, which is fine as they don't own Ball*
+    m_scene->clear(); // This also deletes BallItem objects, which only refer to balls by id
 
     for (int i = 0; i < Grid::GRID_SIZE; ++i) {
         for (int j = 0; j < Grid::GRID_SIZE; ++j) {
@@ -126,27 +121,26 @@ void MainWindow::drawGrid() {
 
     for (int i = 0; i < Grid::GRID_SIZE; ++i) {
         for (int j = 0; j < Grid::GRID_SIZE; ++j) {
-            Ball* ball = m_grid.getBallAt(i, j);
-            if (ball) {
+            Ball ball = m_grid.getBallAt(i, j);
+            if (!ball.isEmpty()) {
                 drawBall(i, j, ball);
             }
         }
     }
 }
 
-void MainWindow::drawBall(int x, int y, Ball* ball) {
-    if (!ball) return;
-    QString color = ball->getColor();
-    if (m_ballPixmaps.contains(color)) {
-        const QPixmap& pixmap = m_ballPixmaps[color];
-        BallItem* ballItem = new BallItem(ball, pixmap);
+void MainWindow::drawBall(int x, int y, const Ball& ball) {
+    if (ball.isEmpty()) return;
+    const QPixmap& pixmap = m_ballPixmaps[static_cast<int>(ball.getColor())];
+    if (!pixmap.isNull()) {
+        BallItem* ballItem = new BallItem(ball.getId(), pixmap);
         ballItem->setPos(x * CELL_SIZE, y * CELL_SIZE);
         ballItem->setZValue(0); // Default Z value
         ballItem->setScale(1.0); // Default scale
         ballItem->setOpacity(1.0); // Default opacity
         m_scene->addItem(ballItem);
     } else {
-        qWarning() << "No pixmap found for color:" << color;
+        qWarning() << "No pixmap found for color:" << ballColorName(ball.getColor());
         QGraphicsEllipseItem* placeholder = new QGraphicsEllipseItem(x * CELL_SIZE + 5, y * CELL_SIZE + 5, CELL_SIZE - 10, CELL_SIZE - 10);
         placeholder->setBrush(Qt::magenta);
         m_scene->addItem(placeholder);
@@ -201,7 +195,7 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
                 if (m_grid.isCellEmpty(gridX, gridY)) {
                     QList<QPoint> path = m_pathfinder.findPath(m_selectedGridPos, clickedGridPos);
                     if (!path.isEmpty()) {
-                        m_ballBeingMoved = m_selectedBallItem->getBall();
+                        m_movingBallId = m_selectedBallItem->getBallId();
                         m_targetMovePos = clickedGridPos;
 
                         highlightBallItem(m_selectedBallItem, false); // Remove selection highlight before animation
@@ -230,7 +224,7 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
 
                         // The m_selectedBallItem will be cleared in onAnimationFinished
                         // No, we need to keep m_selectedBallItem for onAnimationFinished to update grid
-                        // but m_ballBeingMoved and m_targetMovePos are what's critical
+                        // but m_movingBallId and m_targetMovePos are what's critical
                     } else { // No path
                         highlightBallItem(m_selectedBallItem, false);
                         m_selectedBallItem = nullptr; // Deselect
@@ -249,83 +243,29 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
 void MainWindow::onAnimationFinished() {
     m_isAnimating = false; // Re-enable clicks
 
-    if (m_ballBeingMoved && m_selectedBallItem) { // Check if animation was for a valid move
-        // Update grid logic
-        m_grid.removeBall(m_selectedGridPos.x(), m_selectedGridPos.y());
-        m_grid.placeBall(m_targetMovePos.x(), m_targetMovePos.y(), m_ballBeingMoved);
-
+    // 1. Resolve the whole turn in the engine: the move, its lines, the upcoming balls
+    //    if the move made no line, their lines, the score under GameRules and game over
+    bool gameOver = false;
+    bool validMove = m_targetMovePos.x() >= 0 && m_targetMovePos.x() < Grid::GRID_SIZE &&
+                     m_targetMovePos.y() >= 0 && m_targetMovePos.y() < Grid::GRID_SIZE;
+    if (m_movingBallId != 0 && m_selectedBallItem && validMove) { // Check if animation was for a valid move
         // m_selectedBallItem's position is already updated by the animation.
-        // No need to delete m_selectedBallItem graphics object explicitly if drawGrid() is called.
-        // If not calling drawGrid(), one would need to update the BallItem's associated Ball pointer
-        // if a new BallItem is created for the target cell, or simply update its grid coords.
-    }
-
-    // Clear selection state related to the move
-    m_ballBeingMoved = nullptr; // Clear the ball that was being moved
-    bool playerMadeLine = false;
+        // The grid carries the moved ball's id to its new cell; drawGrid() below redraws the rest.
+        colorlines::TurnResult turn =
+            m_grid.playTurn<GameRules>(m_selectedGridPos, m_targetMovePos, m_upcomingBallColors);
 
-    // 1. Check if the player's move resulted in a line
-    if (m_targetMovePos.x() >= 0 && m_targetMovePos.x() < Grid::GRID_SIZE &&
-        m_targetMovePos.y() >= 0 && m_targetMovePos.y() < Grid::GRID_SIZE) {
-
-        QList<QPoint> clearedPlayerPositions = m_solver.checkForLines(m_targetMovePos.x(), m_targetMovePos.y());
-
-        if (!clearedPlayerPositions.isEmpty()) {
-            playerMadeLine = true;
-            for (const QPoint& pos : clearedPlayerPositions) {
-                Ball* ballToRemove = m_grid.removeBall(pos.x(), pos.y());
-                if (ballToRemove) delete ballToRemove;
-            }
-            int baseScore = clearedPlayerPositions.size() * 2;
-            if (clearedPlayerPositions.size() >= 5) baseScore += (clearedPlayerPositions.size() - 4) * clearedPlayerPositions.size();
-            m_score += baseScore;
+        // 2. Apply the result to the UI
+        if (turn.score != 0) {
+            m_score += turn.score;
             m_scoreLabel->setText(QString("Score: %1").arg(m_score));
         }
+        gameOver = turn.gameOver;
     } else {
         qWarning() << "onAnimationFinished called with invalid m_targetMovePos, or no move was made.";
     }
 
-    // 2. If player's move did NOT make a line, add upcoming balls and check for lines again
-    if (!playerMadeLine) {
-        QList<QPoint> newlyPlacedBallsPositions;
-        bool allUpcomingPlacedSuccessfully = true;
-        for (const QString& color : m_upcomingBallColors) {
-            QPoint placedPos = m_grid.placeRandomBall(color);
-            if (placedPos.x() < 0 || placedPos.y() < 0) {
-                allUpcomingPlacedSuccessfully = false;
-                // Game might end here if a ball cannot be placed.
-                // This specific ball (and subsequent ones this turn) won't be placed.
-                break;
-            }
-            newlyPlacedBallsPositions.append(placedPos);
-        }
-
-        // Check if these newly placed balls formed lines
-        if (!newlyPlacedBallsPositions.isEmpty()) {
-            QSet<QPoint> linesFromNewBallsSet;
-            for (const QPoint& p : newlyPlacedBallsPositions) {
-                QList<QPoint> line = m_solver.checkForLines(p.x(), p.y());
-                for(const QPoint& lp : line) linesFromNewBallsSet.insert(lp);
-            }
-
-            if (!linesFromNewBallsSet.isEmpty()) {
-                for (const QPoint& pos : linesFromNewBallsSet) {
-                    Ball* b = m_grid.removeBall(pos.x(), pos.y());
-                    if (b) {
-                        delete b;
-                        m_score++; // Simple score for automatic line clears
-                    }
-                }
-                m_scoreLabel->setText(QString("Score: %1").arg(m_score));
-            }
-        }
-
-        // If not all upcoming balls could be placed, the game might be over.
-        // This is checked after drawGrid and generating next upcoming balls.
-        if (!allUpcomingPlacedSuccessfully) {
-             // Handled by checkGameOver below
-        }
-    }
+    // Clear selection state related to the move
+    m_movingBallId = 0; // Clear the ball that was being moved
 
     // 3. Always generate and display the *next* set of upcoming balls
     generateUpcomingBalls();
@@ -336,8 +276,8 @@ void MainWindow::onAnimationFinished() {
     drawGrid();
     m_selectedBallItem = nullptr;
 
-    // 5. Check for game over
-    if (checkGameOver()) {
+    // 5. Game over if the turn left no empty cell
+    if (gameOver) {
         // Ensure no animation is running if game over is declared from a non-move scenario
         // (e.g. grid fills up after adding upcoming balls without player move)
         if (m_ballAnimation->state() == QAbstractAnimation::Stopped) {
@@ -353,7 +293,7 @@ void MainWindow::onAnimationFinished() {
     }
 }
 
-// Implement generateUpcomingBalls, displayUpcomingBalls, checkGameOver
+// Implement generateUpcomingBalls, displayUpcomingBalls
 
 void MainWindow::generateUpcomingBalls() {
     m_upcomingBallColors.clear();
@@ -366,26 +306,16 @@ void MainWindow::displayUpcomingBalls() {
     // m_upcomingBallLabels is an array of 3 QLabel*
     for (int i = 0; i < 3; ++i) {
         if (i < m_upcomingBallColors.size() && m_upcomingBallLabels[i]) {
-            const QString& color = m_upcomingBallColors.at(i);
-            if (m_ballPixmaps.contains(color)) {
-                m_upcomingBallLabels[i]->setPixmap(m_ballPixmaps.value(color));
+            BallColor color = m_upcomingBallColors.at(i);
+            const QPixmap& pixmap = m_ballPixmaps[static_cast<int>(color)];
+            if (!pixmap.isNull()) {
+                m_upcomingBallLabels[i]->setPixmap(pixmap);
             } else {
                 m_upcomingBallLabels[i]->setText("?"); // Fallback if pixmap missing
-                qWarning() << "Missing pixmap for upcoming ball color:" << color;
+                qWarning() << "Missing pixmap for upcoming ball color:" << ballColorName(color);
             }
         } else if (m_upcomingBallLabels[i]) {
             m_upcomingBallLabels[i]->clear(); // Clear if no color (should not happen)
         }
     }
 }
-
-bool MainWindow::checkGameOver() {
-    // Game is over if there are no empty cells for new balls to be placed.
-    // This check is typically done *after* attempting to place upcoming balls.
-    // If placeRandomBall fails because grid is full, that's a game over.
-    // A simpler check here is just if the grid has any empty cells left.
-    // The logic in onAnimationFinished for placing upcoming balls already checks
-    // if placeRandomBall fails. If allUpcomingPlacedSuccessfully is false after that loop,
-    // and no lines were cleared to make space, it implies game over.
-    return m_grid.getEmptyCells().isEmpty();
-}
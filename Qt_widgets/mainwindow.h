@@ -5,7 +5,6 @@
 #include <QGraphicsView> // For QGraphicsView forward declaration, actual include in .cpp
 #include <QGraphicsScene> // For QGraphicsScene forward declaration
 #include <QLabel> // For QLabel forward declaration
-#include <QMap>
 #include <QString>
 #include <QPixmap>
 #include "Grid.h"       // Definition of Grid
@@ -13,7 +12,7 @@
 #include "Pathfinder.h" // Definition of Pathfinder
 // #include <QPointer>  // QPointer is not suitable for QGraphicsItem
 #include <QPropertyAnimation> // For QPropertyAnimation
-#include "Solver.h"           // Definition of Solver
+#include "Rules.h"            // Rulesets from the core library
 
 // Forward declarations for Qt UI classes used in the .cpp file
 QT_BEGIN_NAMESPACE
@@ -32,6 +31,9 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
+    // Line length, directions and scoring of this frontend; any colorlines::Ruleset works.
+    using GameRules = colorlines::QuadraticRules;
+
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
@@ -44,9 +46,8 @@ private:
     QLabel* m_upcomingBallLabels[3]; // For upcoming balls
 
     Grid m_grid; // The game grid logic
-    QMap<QString, QPixmap> m_ballPixmaps; // Cache for ball images
+    QPixmap m_ballPixmaps[BALL_COLOR_COUNT]; // Cache for ball images, indexed by BallColor
     Pathfinder m_pathfinder; // Pathfinder instance
-    Solver m_solver;         // Solver instance
 
     int m_score = 0;         // Player's score
 
@@ -54,22 +55,21 @@ private:
     QPoint m_selectedGridPos;              // Grid coordinates of the selected ball
 
     QPropertyAnimation* m_ballAnimation;   // For animating ball movement
-    Ball* m_ballBeingMoved = nullptr;      // Pointer to the ball being animated
+    int m_movingBallId = 0;                // Id of the ball being animated, 0 if none
     QPoint m_targetMovePos;                // Target grid position for the animated ball
     bool m_isAnimating = false;            // Flag to disable clicks during animation
 
-    QList<QString> m_upcomingBallColors;   // Stores colors for the next set of balls
+    QList<BallColor> m_upcomingBallColors; // Stores colors for the next set of balls
 
     void setupUI(); // Helper to set up initial UI elements
     void loadBallPixmaps();
     void drawGrid(); // Clears scene and redraws grid cells and all balls
-    void drawBall(int x, int y, Ball* ball); // Adds a single BallItem to the scene
+    void drawBall(int x, int y, const Ball& ball); // Adds a single BallItem to the scene
 
     void highlightBallItem(BallItem* item, bool highlight); // Visual feedback for selection
 
     void generateUpcomingBalls(); // Generates 3 new upcoming ball colors
     void displayUpcomingBalls();  // Updates the UI to show upcoming balls
-    bool checkGameOver();         // Checks if the grid is full
 
     static const int CELL_SIZE = 50; // Define cell size, matches scene setup
 
@@ -0,0 +1,41 @@
+#include "Ball.h"
+
+namespace colorlines {
+
+const char* ballColorName(BallColor color) {
+    static const char* const names[BALL_COLOR_COUNT] = {
+        "", "red", "green", "blue", "yellow", "purple", "pink", "brown", "turquoise"
+    };
+    return names[static_cast<int>(color)];
+}
+
+Ball::Ball(BallColor color, int id) : m_color(color), m_id(id) {
+    // Constructor body can be empty if initialization list suffices
+}
+
+BallColor Ball::getColor() const {
+    return m_color;
+}
+
+int Ball::getId() const {
+    return m_id;
+}
+
+bool Ball::isEmpty() const {
+    return m_color == BallColor::EMPTY;
+}
+
+void Ball::setColor(BallColor color) {
+    m_color = color;
+}
+
+const Ball& Ball::forColor(BallColor color) {
+    static const Ball ballsByColor[BALL_COLOR_COUNT] = {
+        Ball(BallColor::EMPTY), Ball(BallColor::RED), Ball(BallColor::GREEN),
+        Ball(BallColor::BLUE), Ball(BallColor::YELLOW), Ball(BallColor::PURPLE),
+        Ball(BallColor::PINK), Ball(BallColor::BROWN), Ball(BallColor::TURQUOISE)
+    };
+    return ballsByColor[static_cast<int>(color)];
+}
+
+} // namespace colorlines
@@ -0,0 +1,46 @@
+#ifndef COLORLINES_BALL_H
+#define COLORLINES_BALL_H
+
+namespace colorlines {
+
+enum class BallColor : unsigned char {
+    EMPTY,
+    RED,
+    GREEN,
+    BLUE,
+    YELLOW,
+    PURPLE,
+    PINK,
+    BROWN,
+    TURQUOISE
+    // Add more colors if needed
+};
+
+// Number of BallColor values, EMPTY included. Keep in sync with the enum above.
+const int BALL_COLOR_COUNT = 9;
+
+// Lower-case display name ("red", "turquoise", ...); empty for BallColor::EMPTY.
+const char* ballColorName(BallColor color);
+
+// Value describing the ball in a cell: its colour plus an optional id that frontends
+// use to track individual balls (0 when unused). An EMPTY ball stands for an empty cell.
+class Ball {
+public:
+    Ball(BallColor color = BallColor::EMPTY, int id = 0);
+
+    BallColor getColor() const;
+    int getId() const;
+    bool isEmpty() const;
+    void setColor(BallColor color);
+
+    // Shared immutable Ball of the given colour, for grids that only store colour masks.
+    static const Ball& forColor(BallColor color);
+
+private:
+    BallColor m_color;
+    int m_id;
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_BALL_H
@@ -0,0 +1,86 @@
+#ifndef COLORLINES_BITBOARD_H
+#define COLORLINES_BITBOARD_H
+
+#include <cstdint>
+
+namespace colorlines {
+
+// 128-bit cell mask. Bit i stands for cell i in row-major order (r * width + c),
+// so any board with up to 128 cells (9x9, 11x11, ...) fits in two machine words.
+class Bitboard {
+public:
+    static const int BITS = 128;
+
+    constexpr Bitboard() : m_lo(0), m_hi(0) {}
+    constexpr Bitboard(uint64_t lo, uint64_t hi) : m_lo(lo), m_hi(hi) {}
+
+    // Mask with only bit 'index' set.
+    static constexpr Bitboard bit(int index) {
+        return index < 64 ? Bitboard(uint64_t(1) << index, 0)
+                          : Bitboard(0, uint64_t(1) << (index - 64));
+    }
+
+    // Mask with the lowest 'count' bits set (0 <= count <= 128).
+    static constexpr Bitboard lowBits(int count) {
+        return count <= 0   ? Bitboard()
+             : count < 64   ? Bitboard((uint64_t(1) << count) - 1, 0)
+             : count == 64  ? Bitboard(~uint64_t(0), 0)
+             : count < 128  ? Bitboard(~uint64_t(0), (uint64_t(1) << (count - 64)) - 1)
+                            : Bitboard(~uint64_t(0), ~uint64_t(0));
+    }
+
+    constexpr bool test(int index) const {
+        return index < 64 ? (m_lo >> index) & 1 : (m_hi >> (index - 64)) & 1;
+    }
+    void set(int index) { *this |= bit(index); }
+    void reset(int index) { *this &= ~bit(index); }
+
+    constexpr bool any() const { return (m_lo | m_hi) != 0; }
+    constexpr bool none() const { return !any(); }
+    int count() const { return __builtin_popcountll(m_lo) + __builtin_popcountll(m_hi); }
+
+    // Index of the lowest set bit, or -1 if the mask is empty.
+    int lowestBit() const {
+        if (m_lo) return __builtin_ctzll(m_lo);
+        if (m_hi) return 64 + __builtin_ctzll(m_hi);
+        return -1;
+    }
+    // Clears the lowest set bit and returns its index (mask must not be empty).
+    int popLowestBit() {
+        int index = lowestBit();
+        if (m_lo) m_lo &= m_lo - 1;
+        else m_hi &= m_hi - 1;
+        return index;
+    }
+
+    constexpr uint64_t low() const { return m_lo; }
+    constexpr uint64_t high() const { return m_hi; }
+
+    constexpr Bitboard operator~() const { return Bitboard(~m_lo, ~m_hi); }
+    constexpr Bitboard operator&(const Bitboard& o) const { return Bitboard(m_lo & o.m_lo, m_hi & o.m_hi); }
+    constexpr Bitboard operator|(const Bitboard& o) const { return Bitboard(m_lo | o.m_lo, m_hi | o.m_hi); }
+    constexpr Bitboard operator^(const Bitboard& o) const { return Bitboard(m_lo ^ o.m_lo, m_hi ^ o.m_hi); }
+    Bitboard& operator&=(const Bitboard& o) { m_lo &= o.m_lo; m_hi &= o.m_hi; return *this; }
+    Bitboard& operator|=(const Bitboard& o) { m_lo |= o.m_lo; m_hi |= o.m_hi; return *this; }
+    Bitboard& operator^=(const Bitboard& o) { m_lo ^= o.m_lo; m_hi ^= o.m_hi; return *this; }
+    constexpr bool operator==(const Bitboard& o) const { return m_lo == o.m_lo && m_hi == o.m_hi; }
+    constexpr bool operator!=(const Bitboard& o) const { return !(*this == o); }
+
+    // Logical shifts across the full 128 bits (0 <= n < 128). Done on a 128-bit integer
+    // so the compiler emits a branch-free double-word shift even for runtime 'n'.
+    constexpr Bitboard operator<<(int n) const { return fromWide(wide() << n); }
+    constexpr Bitboard operator>>(int n) const { return fromWide(wide() >> n); }
+
+private:
+    __extension__ typedef unsigned __int128 Wide;
+
+    constexpr Wide wide() const { return (Wide(m_hi) << 64) | m_lo; }
+    static constexpr Bitboard fromWide(Wide value) { return Bitboard(uint64_t(value), uint64_t(value >> 64)); }
+
+    uint64_t m_lo; // cells 0..63
+    uint64_t m_hi; // cells 64..127
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_BITBOARD_H
@@ -0,0 +1,165 @@
+#include "BoardBatch.h"
+#include <cstring>
+
+namespace colorlines {
+
+namespace {
+
+const int LANES = 4; // Boards per group: one AVX2 register of 64-bit words, or two SSE2 ones
+
+// Four boards' copy of one 64-bit mask word. GCC/Clang lower the operators to AVX2 or
+// SSE2 instructions depending on the target of the function they end up in.
+typedef uint64_t Lanes __attribute__((vector_size(LANES * sizeof(uint64_t))));
+
+// A 128-bit mask for a group of boards.
+struct Wide {
+    Lanes lo;
+    Lanes hi;
+};
+
+struct DirectionInfo {
+    int shift;       // 1..127
+    uint64_t guardLo; // Guard mask words
+    uint64_t guardHi;
+};
+
+// Bitboard's operators for Wide, so LineDetector's shared run steps work on it.
+inline __attribute__((always_inline)) Wide operator>>(const Wide& value, int n) {
+    if (n < 64) return {(value.lo >> n) | (value.hi << (64 - n)), value.hi >> n}; // n >= 1
+    return {value.hi >> (n - 64), value.hi ^ value.hi};
+}
+
+inline __attribute__((always_inline)) Wide operator<<(const Wide& value, int n) {
+    if (n < 64) return {value.lo << n, (value.hi << n) | (value.lo >> (64 - n))};
+    return {value.lo ^ value.lo, value.lo << (n - 64)};
+}
+
+inline __attribute__((always_inline)) Wide operator&(const Wide& a, const Wide& b) { return {a.lo & b.lo, a.hi & b.hi}; }
+inline __attribute__((always_inline)) Wide operator|(const Wide& a, const Wide& b) { return {a.lo | b.lo, a.hi | b.hi}; }
+
+inline __attribute__((always_inline)) Wide load(const uint64_t* lo, const uint64_t* hi) {
+    Wide value;
+    std::memcpy(&value.lo, lo, sizeof(Lanes));
+    std::memcpy(&value.hi, hi, sizeof(Lanes));
+    return value;
+}
+
+// LineDetector::lineCells(colorMasks, ...) for LANES boards at a time; inlined into each
+// target-specific entry point below so it is compiled once per instruction set.
+inline __attribute__((always_inline)) void detectGroups(const uint64_t* masks, uint64_t* clear, int stride,
+                                                        const DirectionInfo* directions, int minLength) {
+    for (int first = 0; first < stride; first += LANES) {
+        Wide colors[BALL_COLOR_COUNT];
+        for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+            colors[color] = load(masks + (size_t(color) * 2) * stride + first,
+                                 masks + (size_t(color) * 2 + 1) * stride + first);
+        }
+        Lanes zero = colors[1].lo ^ colors[1].lo;
+        Wide cells = {zero, zero};
+        for (int d = 0; d < LineDetector::DIRECTION_COUNT; ++d) {
+            int shift = directions[d].shift;
+            Wide pairs = LineDetector::samePairs(colors, BALL_COLOR_COUNT, shift);
+            pairs.lo &= directions[d].guardLo;
+            pairs.hi &= directions[d].guardHi;
+            cells = cells | LineDetector::runsFromPairs(pairs, shift, minLength);
+        }
+        std::memcpy(clear + first, &cells.lo, sizeof(Lanes));
+        std::memcpy(clear + stride + first, &cells.hi, sizeof(Lanes));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+void detectAvx2(const uint64_t* masks, uint64_t* clear, int stride, const DirectionInfo* directions, int minLength) {
+    detectGroups(masks, clear, stride, directions, minLength);
+}
+#endif
+
+void detectBaseline(const uint64_t* masks, uint64_t* clear, int stride, const DirectionInfo* directions, int minLength) {
+    detectGroups(masks, clear, stride, directions, minLength);
+}
+
+bool hasAvx2() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+BoardBatch::BoardBatch(int width, int height, int boardCount)
+  : m_width(width),
+    m_height(height),
+    m_boardCount(boardCount),
+    m_stride((boardCount + LANES - 1) / LANES * LANES),
+    m_detector(width, height),
+    m_masks(size_t(BALL_COLOR_COUNT) * 2 * m_stride, 0),
+    m_clear(size_t(2) * m_stride, 0) {
+    assert(boardCount > 0);
+}
+
+BallColor BoardBatch::getCell(int board, int index) const {
+    int word = index / 64;
+    uint64_t bit = uint64_t(1) << (index % 64);
+    for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+        if (maskWord(color, word)[board] & bit) {
+            return static_cast<BallColor>(color);
+        }
+    }
+    return BallColor::EMPTY;
+}
+
+void BoardBatch::setCell(int board, int index, BallColor color) {
+    int word = index / 64;
+    uint64_t bit = uint64_t(1) << (index % 64);
+    for (int other = 1; other < BALL_COLOR_COUNT; ++other) {
+        maskWord(other, word)[board] &= ~bit;
+    }
+    if (color != BallColor::EMPTY) {
+        maskWord(static_cast<int>(color), word)[board] |= bit;
+    }
+}
+
+void BoardBatch::findLines(int minLength) {
+    assert(minLength >= 1);
+    if (minLength == 1) {
+        // Every ball is a line
+        for (int word = 0; word < 2; ++word) {
+            for (int board = 0; board < m_stride; ++board) {
+                uint64_t occupied = 0;
+                for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+                    occupied |= maskWord(color, word)[board];
+                }
+                m_clear[size_t(word) * m_stride + board] = occupied;
+            }
+        }
+        return;
+    }
+
+    DirectionInfo directions[LineDetector::DIRECTION_COUNT];
+    for (int d = 0; d < LineDetector::DIRECTION_COUNT; ++d) {
+        LineDetector::Direction direction = static_cast<LineDetector::Direction>(d);
+        int shift = m_detector.getShift(direction);
+        // A zero shift (down-left on a one-column board) has an empty guard; any step works
+        directions[d] = {shift > 0 ? shift : 1, m_detector.getGuard(direction).low(),
+                         m_detector.getGuard(direction).high()};
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (hasAvx2()) {
+        detectAvx2(m_masks.data(), m_clear.data(), m_stride, directions, minLength);
+        return;
+    }
+#endif
+    detectBaseline(m_masks.data(), m_clear.data(), m_stride, directions, minLength);
+}
+
+void BoardBatch::getClearMasks(Bitboard* masks) const {
+    for (int board = 0; board < m_boardCount; ++board) {
+        masks[board] = getClearMask(board);
+    }
+}
+
+} // namespace colorlines
@@ -0,0 +1,65 @@
+#ifndef COLORLINES_BOARDBATCH_H
+#define COLORLINES_BOARDBATCH_H
+
+#include "Bitboard.h"
+#include "GameGrid.h"
+#include "LineDetector.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace colorlines {
+
+// Many boards of one size stored structure-of-arrays, for simulators that advance thousands
+// of games in lockstep. Each colour mask word (low and high half of the Bitboard) is one
+// array indexed by board, so findLines() runs the LineDetector shift-and-mask steps on
+// several boards per SIMD register (4 with AVX2, 2 with SSE2), streaming the arrays in
+// order. One call gives the same masks as Solver::findLineMask() on every board.
+class BoardBatch {
+public:
+    BoardBatch(int width, int height, int boardCount);
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getBoardCount() const { return m_boardCount; }
+
+    BallColor getCell(int board, int index) const;
+    void setCell(int board, int index, BallColor color);
+
+    // Copies a Board's colour masks into lane 'board'.
+    template <int Width, int Height>
+    void loadBoard(int board, const Board<Width, Height>& source) {
+        assert(source.getWidth() == m_width && source.getHeight() == m_height);
+        const Bitboard* masks = source.getColorMasks();
+        for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+            maskWord(color, 0)[board] = masks[color].low();
+            maskWord(color, 1)[board] = masks[color].high();
+        }
+    }
+
+    // Finds the cells on lines of at least minLength on every board.
+    void findLines(int minLength = 5);
+
+    // Results of the last findLines(), as Solver::findLineMask() would return them.
+    Bitboard getClearMask(int board) const {
+        return Bitboard(m_clear[board], m_clear[m_stride + board]);
+    }
+    void getClearMasks(Bitboard* masks) const;
+
+private:
+    uint64_t* maskWord(int color, int word) { return &m_masks[(size_t(color) * 2 + word) * m_stride]; }
+    const uint64_t* maskWord(int color, int word) const { return &m_masks[(size_t(color) * 2 + word) * m_stride]; }
+
+    int m_width;
+    int m_height;
+    int m_boardCount;
+    int m_stride;                  // Board count rounded up to whole SIMD groups
+    LineDetector m_detector;       // Shifts and edge guards for this board size
+    std::vector<uint64_t> m_masks; // [colour][word][board]; the EMPTY colour stays clear
+    std::vector<uint64_t> m_clear; // [word][board]
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_BOARDBATCH_H
@@ -0,0 +1,72 @@
+#include "EmptyRegions.h"
+#include <cassert>
+
+namespace colorlines {
+
+template <int Width, int Height>
+EmptyRegions<Width, Height>::EmptyRegions(const Board<Width, Height>* gameGrid)
+  : m_gameGrid(gameGrid), m_valid(false), m_regionCount(0), m_labels() {
+    assert(m_gameGrid != nullptr);
+    int width = m_gameGrid->getWidth();
+    for (int r = 0; r < m_gameGrid->getHeight(); ++r) {
+        for (int c = 0; c < width; ++c) {
+            if (c > 0) m_notFirstColumn.set(r * width + c);
+            if (c < width - 1) m_notLastColumn.set(r * width + c);
+        }
+    }
+    m_boardMask = Bitboard::lowBits(width * m_gameGrid->getHeight());
+}
+
+template <int Width, int Height>
+void EmptyRegions<Width, Height>::update() {
+    Bitboard empty = m_gameGrid->getEmptyMask();
+    if (m_valid && empty == m_labelledEmpty) {
+        return;
+    }
+    for (int label = 1; label <= m_regionCount; ++label) {
+        Bitboard cells = m_regions[label];
+        while (cells.any()) {
+            m_labels[cells.popLowestBit()] = 0;
+        }
+    }
+
+    // Flood each region from its lowest unlabelled cell
+    m_regionCount = 0;
+    Bitboard unlabelled = empty;
+    while (unlabelled.any()) {
+        Bitboard region = Bitboard::bit(unlabelled.lowestBit());
+        for (;;) {
+            Bitboard grown = region | (neighbours(region) & empty);
+            if (grown == region) break;
+            region = grown;
+        }
+        int label = ++m_regionCount;
+        m_regions[label] = region;
+        unlabelled &= ~region;
+        while (region.any()) {
+            m_labels[region.popLowestBit()] = static_cast<uint8_t>(label);
+        }
+    }
+    m_labelledEmpty = empty;
+    m_valid = true;
+}
+
+template <int Width, int Height>
+Bitboard EmptyRegions<Width, Height>::reachableFrom(int index) {
+    update();
+    Bitboard adjacentEmpty = neighbours(Bitboard::bit(index)) & m_labelledEmpty & m_boardMask;
+    Bitboard reachable;
+    while (adjacentEmpty.any()) {
+        const Bitboard& region = m_regions[m_labels[adjacentEmpty.popLowestBit()]];
+        reachable |= region;
+        adjacentEmpty &= ~region; // Other neighbours in the same region add nothing
+    }
+    return reachable;
+}
+
+template class EmptyRegions<7, 7>;
+template class EmptyRegions<9, 9>;
+template class EmptyRegions<11, 11>;
+template class EmptyRegions<>;
+
+} // namespace colorlines
@@ -0,0 +1,61 @@
+#ifndef COLORLINES_EMPTYREGIONS_H
+#define COLORLINES_EMPTYREGIONS_H
+
+#include "Bitboard.h"
+#include "GameGrid.h"
+#include <cstdint>
+
+namespace colorlines {
+
+// Connected regions of empty cells (orthogonal neighbours) of a Board, labelled with
+// bitboard flood fills. The labels are cached together with the empty-cell mask they were
+// computed from; any placeBall/removeBall changes that mask, so the next query relabels
+// and queries against an unchanged position are table lookups. Both frontends' path
+// searches sit on top of this.
+template <int Width = DYNAMIC_SIZE, int Height = DYNAMIC_SIZE>
+class EmptyRegions {
+public:
+    static const int MAX_REGIONS = Bitboard::BITS / 2; // A checkerboard of empty cells
+
+    EmptyRegions(const Board<Width, Height>* gameGrid);
+
+    // Relabels if the board's empty cells changed since the last call.
+    void update();
+
+    // Region of empty cell 'index' (1 .. getRegionCount()), or 0 for an occupied cell.
+    int getLabel(int index) { update(); return m_labels[index]; }
+    int getRegionCount() { update(); return m_regionCount; }
+    const Bitboard& getRegion(int label) { update(); return m_regions[label]; }
+
+    // Empty cells a ball on cell 'index' can move to: the regions next to it.
+    Bitboard reachableFrom(int index);
+
+    // Cells orthogonally adjacent to any cell of 'cells'.
+    Bitboard neighbours(const Bitboard& cells) const {
+        // Left/right shifts drop cells that would wrap onto the next row; up/down shifts
+        // only fall off the ends of the board
+        return ((cells & m_notLastColumn) << 1) | ((cells & m_notFirstColumn) >> 1) |
+               (cells << m_gameGrid->getWidth()) | (cells >> m_gameGrid->getWidth());
+    }
+
+private:
+    const Board<Width, Height>* m_gameGrid;
+    Bitboard m_notFirstColumn; // Board cells with a left neighbour
+    Bitboard m_notLastColumn;  // Board cells with a right neighbour
+    Bitboard m_boardMask;      // All cells of the board
+
+    bool m_valid;
+    Bitboard m_labelledEmpty;              // Empty cells the labels were computed for
+    int m_regionCount;
+    uint8_t m_labels[Bitboard::BITS];      // Region per cell, 0 for occupied cells
+    Bitboard m_regions[MAX_REGIONS + 1];   // Cells of each region, indexed by label
+};
+
+extern template class EmptyRegions<7, 7>;
+extern template class EmptyRegions<9, 9>;
+extern template class EmptyRegions<11, 11>;
+extern template class EmptyRegions<>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_EMPTYREGIONS_H
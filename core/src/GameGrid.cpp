@@ -0,0 +1,139 @@
+#include "GameGrid.h"
+#include <vector>
+#include <random>    // For std::random_device, std::uniform_int_distribution
+#include <cassert>
+
+namespace colorlines {
+
+template <int Width, int Height>
+Board<Width, Height>::Board(int width, int height)
+  : BoardDimensions<Width, Height>(width, height),
+    m_boardMask(Bitboard::lowBits(width * height)),
+    m_rng((uint64_t(std::random_device{}()) << 32) | std::random_device{}()), // Initialize RNG
+    m_spawnColorCount(5) {
+    assert(width == getWidth() && height == getHeight());
+    assert(width > 0 && height > 0 && width * height <= Bitboard::BITS);
+    reset();
+}
+
+template <int Width, int Height>
+void Board<Width, Height>::placeBall(int r, int c, BallColor color) {
+    // Assuming r, c are valid.
+    removeBall(r, c);
+    if (color == BallColor::EMPTY) {
+        return;
+    }
+    int index = cellIndex(r, c);
+    m_occupied.set(index);
+    m_colorMasks[static_cast<int>(color)].set(index);
+    m_hash ^= Zobrist::cellKey(index, color);
+
+    // Swap-remove the cell from the empty list
+    int slot = m_emptySlot[index];
+    int last = m_emptyCells[--m_emptyCount];
+    m_emptyCells[slot] = last;
+    m_emptySlot[last] = slot;
+}
+
+template <int Width, int Height>
+void Board<Width, Height>::undoPlaceBall(int r, int c, int slot) {
+    int index = cellIndex(r, c);
+    BallColor color = getColor(index);
+
+    Bitboard keep = ~Bitboard::bit(index);
+    m_occupied &= keep;
+    m_colorMasks[static_cast<int>(color)] &= keep;
+    m_hash ^= Zobrist::cellKey(index, color);
+
+    // Reverse the swap-remove: move the slot's current occupant back to the end. If the cell
+    // was taken from the end itself, the entry at 'slot' is stale and nothing moves.
+    if (slot < m_emptyCount) {
+        int moved = m_emptyCells[slot];
+        m_emptyCells[m_emptyCount] = moved;
+        m_emptySlot[moved] = m_emptyCount;
+    }
+    ++m_emptyCount;
+    m_emptyCells[slot] = index;
+    m_emptySlot[index] = slot;
+}
+
+template <int Width, int Height>
+void Board<Width, Height>::removeBall(int r, int c) {
+    // Assuming r, c are valid.
+    int index = cellIndex(r, c);
+    BallColor color = getColor(index);
+    if (color == BallColor::EMPTY) {
+        return;
+    }
+    m_emptySlot[index] = m_emptyCount;
+    m_emptyCells[m_emptyCount++] = index;
+
+    Bitboard keep = ~Bitboard::bit(index);
+    m_occupied &= keep;
+    m_colorMasks[static_cast<int>(color)] &= keep;
+    m_hash ^= Zobrist::cellKey(index, color);
+}
+
+template <int Width, int Height>
+void Board<Width, Height>::getCells(BallColor* cells) const {
+    int count = getWidth() * getHeight();
+    for (int index = 0; index < count; ++index) {
+        cells[index] = BallColor::EMPTY;
+    }
+    for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+        Bitboard mask = m_colorMasks[color];
+        while (mask.any()) {
+            cells[mask.popLowestBit()] = static_cast<BallColor>(color);
+        }
+    }
+}
+
+template <int Width, int Height>
+BallColor Board<Width, Height>::randomColor() {
+    std::uniform_int_distribution<int> colorDist(1, m_spawnColorCount);
+    return static_cast<BallColor>(colorDist(m_rng));
+}
+
+template <int Width, int Height>
+std::pair<int, int> Board<Width, Height>::placeRandomBall(BallColor color) {
+    if (m_emptyCount == 0) {
+        return {-1, -1};
+    }
+    // A uniform slot of the empty list; placeBall swap-removes it, so the
+    // next pick draws from the remaining empty cells only.
+    std::uniform_int_distribution<int> slotDist(0, m_emptyCount - 1);
+    int index = m_emptyCells[slotDist(m_rng)];
+    std::pair<int, int> cell = {index / getWidth(), index % getWidth()};
+    placeBall(cell.first, cell.second, color);
+    return cell;
+}
+
+template <int Width, int Height>
+std::vector<std::pair<int, int>> Board<Width, Height>::addRandomBalls(int count) {
+    std::vector<std::pair<int, int>> addedBallsCoordinates;
+    for (int i = 0; i < count && m_emptyCount > 0; ++i) {
+        addedBallsCoordinates.push_back(placeRandomBall(randomColor()));
+    }
+    return addedBallsCoordinates;
+}
+
+template <int Width, int Height>
+void Board<Width, Height>::reset() {
+    m_occupied = Bitboard();
+    for (Bitboard& mask : m_colorMasks) {
+        mask = Bitboard();
+    }
+    m_hash = 0;
+    m_emptyCount = getWidth() * getHeight();
+    for (int index = 0; index < m_emptyCount; ++index) {
+        m_emptyCells[index] = index;
+        m_emptySlot[index] = index;
+    }
+}
+
+template class Board<7, 7>;
+template class Board<9, 9>;
+template class Board<11, 11>;
+template class Board<>;
+
+} // namespace colorlines
@@ -0,0 +1,163 @@
+#ifndef COLORLINES_GAMEGRID_H
+#define COLORLINES_GAMEGRID_H
+
+#include "Ball.h"
+#include "Bitboard.h"
+#include "Random.h"
+#include "Zobrist.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <utility> // For std::pair
+
+namespace colorlines {
+
+// Passing DYNAMIC_SIZE as both board dimensions selects a board whose size is chosen at runtime.
+const int DYNAMIC_SIZE = 0;
+
+// Width/height storage for Board. Fixed sizes are compile-time constants and take no space,
+// so loops bounded by getWidth()/getHeight() have constant trip counts.
+template <int Width, int Height>
+class BoardDimensions {
+public:
+    static_assert(Width > 0 && Height > 0, "Use DYNAMIC_SIZE for both dimensions or neither");
+
+    BoardDimensions(int width = Width, int height = Height) {
+        (void)width; (void)height; // Fixed at compile time
+    }
+
+    static constexpr int getWidth() { return Width; }
+    static constexpr int getHeight() { return Height; }
+};
+
+template <>
+class BoardDimensions<DYNAMIC_SIZE, DYNAMIC_SIZE> {
+public:
+    BoardDimensions(int width = 9, int height = 9) : m_width(width), m_height(height) {}
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    int m_width;
+    int m_height;
+};
+
+// The board is stored as bitboards: one occupancy mask plus one mask per BallColor.
+// A cell's colour is read back from the masks, so nothing per-cell is duplicated.
+// Cell (r, c) maps to bit r * width + c, so width * height must not exceed Bitboard::BITS.
+// Board<9, 9>, Board<7, 7> and Board<11, 11> are instantiated in GameGrid.cpp;
+// Board<> (alias GameGrid) takes its size at runtime and covers everything else.
+template <int Width = DYNAMIC_SIZE, int Height = DYNAMIC_SIZE>
+class Board : public BoardDimensions<Width, Height> {
+public:
+    static_assert(Width * Height <= Bitboard::BITS, "Board does not fit in a Bitboard");
+
+    // Entries of the per-cell arrays: exactly the cell count for fixed sizes.
+    static constexpr int CELL_CAPACITY = Width ? Width * Height : Bitboard::BITS;
+
+    Board(int width = Width ? Width : 9, int height = Height ? Height : 9);
+
+    using BoardDimensions<Width, Height>::getWidth;
+    using BoardDimensions<Width, Height>::getHeight;
+
+    const Ball& getBall(int r, int c) const {
+        // Assuming r, c are valid. Add boundary checks if necessary for robustness.
+        return Ball::forColor(getColor(cellIndex(r, c)));
+    }
+    // Colour of the cell with the given index (EMPTY if none).
+    BallColor getColor(int index) const {
+        if (!m_occupied.test(index)) {
+            return BallColor::EMPTY;
+        }
+        int color = 1;
+        while (!m_colorMasks[color].test(index)) {
+            ++color;
+        }
+        return static_cast<BallColor>(color);
+    }
+    // Writes all cell colours in index order (width * height entries), for bulk readers
+    // such as the codec.
+    void getCells(BallColor* cells) const;
+    // Mutable version to allow direct modification if needed, e.g. getBall(r, c).setColor()
+    // Ball& getBall(int r, int c); // Decided against this to enforce using placeBall/removeBall
+    void placeBall(int r, int c, BallColor color);
+    void removeBall(int r, int c);
+    // Exact inverse of placeBall() onto an empty cell: the cell goes back into 'slot' of the
+    // empty-cell list (read with getEmptySlot() right after placing), so spawns replay identically.
+    void undoPlaceBall(int r, int c, int slot);
+    bool isCellEmpty(int r, int c) const {
+        // Assuming r, c are valid.
+        return !m_occupied.test(cellIndex(r, c));
+    }
+
+    int cellIndex(int r, int c) const { return r * getWidth() + c; }
+
+    // Spawns up to 'count' random balls on empty cells in O(count).
+    std::vector<std::pair<int, int>> addRandomBalls(int count);
+    // Places a ball of the given colour on a random empty cell; returns its (r, c),
+    // or (-1, -1) if the board is full.
+    std::pair<int, int> placeRandomBall(BallColor color);
+    // Uniformly random colour among the first getSpawnColorCount() non-empty colours.
+    BallColor randomColor();
+    // Spawns draw from RED onwards in enum order; the classic game uses 5 colours.
+    // 'count' must be between 1 and BALL_COLOR_COUNT - 1 (every non-empty colour).
+    void setSpawnColorCount(int count) {
+        assert(count >= 1 && count < BALL_COLOR_COUNT);
+        m_spawnColorCount = count;
+    }
+    int getSpawnColorCount() const { return m_spawnColorCount; }
+    bool isFull() const { return m_emptyCount == 0; }
+    int getEmptyCount() const { return m_emptyCount; }
+    // Cell index stored in the given slot (0 <= slot < getEmptyCount()) of the empty-cell list.
+    int getEmptyCell(int slot) const { return m_emptyCells[slot]; }
+    // Slot of a cell in the empty-cell list. For an occupied cell this is the slot it had
+    // when it was filled, until it is emptied again.
+    int getEmptySlot(int index) const { return m_emptySlot[index]; }
+    void reset(); // Added reset method
+
+    // Raw bitboard access for bots and line/path searches.
+    const Bitboard& getOccupied() const { return m_occupied; }
+    const Bitboard& getColorMask(BallColor color) const { return m_colorMasks[static_cast<int>(color)]; }
+    // All colour masks, indexed by BallColor (BALL_COLOR_COUNT entries; EMPTY's is clear).
+    const Bitboard* getColorMasks() const { return m_colorMasks; }
+    Bitboard getEmptyMask() const { return m_boardMask & ~m_occupied; }
+    // Mask of all cells that exist on this board.
+    const Bitboard& getBoardMask() const { return m_boardMask; }
+
+    // Zobrist hash of the cell colours, updated by XOR in placeBall/removeBall.
+    // XOR in Zobrist::upcomingKey() values to also cover a queue of upcoming balls.
+    uint64_t getHash() const { return m_hash; }
+
+    // Spawn RNG position, for saving/restoring the board exactly.
+    uint64_t getRngState() const { return m_rng.getState(); }
+    void setRngState(uint64_t state) { m_rng.setState(state); }
+
+private:
+    Bitboard m_boardMask;
+    Bitboard m_occupied;
+    Bitboard m_colorMasks[BALL_COLOR_COUNT]; // Indexed by BallColor; the EMPTY slot stays clear
+
+    // Dense list of empty cell indices plus each cell's slot in it, kept in step by
+    // placeBall/removeBall with swap-remove. See getEmptySlot() for occupied cells.
+    unsigned char m_emptyCells[CELL_CAPACITY];
+    unsigned char m_emptySlot[CELL_CAPACITY];
+    int m_emptyCount;
+
+    uint64_t m_hash;
+
+    SplitMix64 m_rng; // Spawn RNG; one word of state so board copies stay small
+    int m_spawnColorCount;
+};
+
+extern template class Board<7, 7>;
+extern template class Board<9, 9>;
+extern template class Board<11, 11>;
+extern template class Board<>;
+
+// Runtime-sized board for custom dimensions.
+using GameGrid = Board<>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_GAMEGRID_H
@@ -0,0 +1,67 @@
+#include "LineDetector.h"
+#include <cassert>
+
+namespace colorlines {
+
+LineDetector::LineDetector(int width, int height) : m_width(width), m_height(height) {
+    assert(width > 0 && height > 0 && width * height <= Bitboard::BITS);
+
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        Direction direction = static_cast<Direction>(d);
+        m_shift[d] = directionShift(width, direction);
+        m_guard[d] = directionGuard(width, height, direction);
+    }
+}
+
+Bitboard LineDetector::runs(const Bitboard& mask, Direction direction, int minLength) const {
+    assert(minLength >= 1);
+    if (minLength == 1) {
+        return mask;
+    }
+    int shift = m_shift[direction];
+    return runsFromPairs(mask & m_guard[direction] & (mask >> shift), shift, minLength);
+}
+
+Bitboard LineDetector::lineCells(const Bitboard& mask, int minLength) const {
+    return runs(mask, HORIZONTAL, minLength) | runs(mask, VERTICAL, minLength) |
+           runs(mask, DIAGONAL, minLength) | runs(mask, ANTI_DIAGONAL, minLength);
+}
+
+Bitboard LineDetector::lineCells(const Bitboard* colorMasks, int colorCount, int minLength) const {
+    assert(minLength >= 1);
+    Bitboard cells;
+    if (minLength == 1) {
+        for (int color = 0; color < colorCount; ++color) {
+            cells |= colorMasks[color];
+        }
+        return cells;
+    }
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        int shift = m_shift[d];
+        cells |= runsFromPairs(samePairs(colorMasks, colorCount, shift) & m_guard[d], shift, minLength);
+    }
+    return cells;
+}
+
+Bitboard LineDetector::lineCellsThrough(const Bitboard& mask, int index, int minLength) const {
+    Bitboard result;
+    Bitboard origin = Bitboard::bit(index);
+    int longestRun = m_width > m_height ? m_width : m_height;
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        Direction direction = static_cast<Direction>(d);
+        Bitboard directionRuns = runs(mask, direction, minLength);
+        int shift = m_shift[d];
+        const Bitboard& guard = m_guard[d];
+        // Grow from the origin one step each way inside the runs; the guard keeps
+        // growth from wrapping onto a neighbouring row, and cells outside the runs
+        // (including an origin that is not on one) stop it
+        Bitboard run = origin & directionRuns;
+        for (int k = 1; k < longestRun; ++k) {
+            run |= (((run & guard) << shift) | ((run >> shift) & guard)) & directionRuns;
+        }
+        result |= run;
+    }
+    return result;
+}
+
+} // namespace colorlines
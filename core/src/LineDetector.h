@@ -0,0 +1,107 @@
+#ifndef COLORLINES_LINEDETECTOR_H
+#define COLORLINES_LINEDETECTOR_H
+
+#include "Bitboard.h"
+
+namespace colorlines {
+
+// Branch-free line detection on occupancy masks. For each of the four directions the
+// mask is ANDed with copies of itself shifted by one step along that direction, so after
+// minLength - 1 rounds only the first cell of every run of at least minLength remains;
+// shifting those starts back out yields the run cells. Guard masks drop cells whose next
+// step would leave the board (wrap to the next row), so runs never cross an edge.
+// Works on any board that fits in a Bitboard; the cost is a few dozen 128-bit operations
+// per direction, independent of how many balls there are.
+class LineDetector {
+public:
+    enum Direction { HORIZONTAL, VERTICAL, DIAGONAL, ANTI_DIAGONAL, DIRECTION_COUNT };
+
+    LineDetector(int width, int height);
+
+    // Cells of 'mask' that lie on a straight run of at least minLength cells in 'direction'.
+    Bitboard runs(const Bitboard& mask, Direction direction, int minLength) const;
+    // Cells of 'mask' on a run of at least minLength cells in any direction.
+    Bitboard lineCells(const Bitboard& mask, int minLength) const;
+    // Cells on a run of at least minLength same-coloured cells, given one mask per colour.
+    // All colours are folded into one same-colour-neighbour mask per direction first,
+    // so a whole board costs about as much as a single colour.
+    Bitboard lineCells(const Bitboard* colorMasks, int colorCount, int minLength) const;
+    // Like lineCells(), restricted to the runs that contain cell 'index'.
+    Bitboard lineCellsThrough(const Bitboard& mask, int index, int minLength) const;
+
+    // Index step of a direction, and the cells whose next step stays on the board.
+    int getShift(Direction direction) const { return m_shift[direction]; }
+    const Bitboard& getGuard(Direction direction) const { return m_guard[direction]; }
+
+    // The steps shared by every shift-and-mask line finder (this class, RuleEngine with its
+    // compile-time shifts and guards, BoardBatch across boards). 'Mask' is Bitboard or any
+    // type with the same &, |, << and >> operators.
+
+    // Index step of a direction on a board 'width' cells wide. Down-left uses step
+    // width - 1, so the four directions all move to higher indices.
+    static constexpr int directionShift(int width, Direction direction) {
+        return direction == HORIZONTAL ? 1
+             : direction == VERTICAL   ? width
+             : direction == DIAGONAL   ? width + 1
+                                       : width - 1;
+    }
+
+    // Cells of a width x height board whose next step in 'direction' stays on the board.
+    static constexpr Bitboard directionGuard(int width, int height, Direction direction) {
+        Bitboard mask;
+        for (int r = 0; r < height; ++r) {
+            for (int c = 0; c < width; ++c) {
+                bool hasRight = c < width - 1;
+                bool hasLeft = c > 0;
+                bool hasBelow = r < height - 1;
+                bool inside = direction == HORIZONTAL ? hasRight
+                            : direction == VERTICAL   ? hasBelow
+                            : direction == DIAGONAL   ? hasRight && hasBelow
+                                                      : hasLeft && hasBelow;
+                if (inside) mask = mask | Bitboard::bit(r * width + c);
+            }
+        }
+        return mask;
+    }
+
+    // Cells whose next cell 'shift' further holds the same colour, over colours
+    // 1 .. colorCount - 1 at once (index 0 is EMPTY and is skipped). Not guarded yet.
+    template <class Mask>
+    static constexpr Mask samePairs(const Mask* colorMasks, int colorCount, int shift) {
+        Mask pairs = colorMasks[1] & (colorMasks[1] >> shift);
+        for (int color = 2; color < colorCount; ++color) {
+            pairs = pairs | (colorMasks[color] & (colorMasks[color] >> shift));
+        }
+        return pairs;
+    }
+
+    // Expands a guarded mask of 'same as next cell' bits into the cells of runs of at
+    // least minLength (>= 2) cells.
+    template <class Mask>
+    static constexpr Mask runsFromPairs(const Mask& pairs, int shift, int minLength) {
+        // After round k, bit i is set iff pairs i, i + shift, ..., i + k * shift are all set,
+        // i.e. cells i .. i + (k + 1) * shift form a run
+        Mask starts = pairs;
+        for (int k = 2; k < minLength; ++k) {
+            starts = starts & (starts >> shift);
+        }
+        // Each start covers the minLength cells of its window; overlapping windows merge
+        // into the full run
+        Mask cells = starts;
+        for (int k = 1; k < minLength; ++k) {
+            starts = starts << shift;
+            cells = cells | starts;
+        }
+        return cells;
+    }
+
+private:
+    int m_width;
+    int m_height;
+    int m_shift[DIRECTION_COUNT];     // Index step of each direction
+    Bitboard m_guard[DIRECTION_COUNT]; // Cells whose next step in the direction stays on the board
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_LINEDETECTOR_H
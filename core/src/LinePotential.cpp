@@ -0,0 +1,118 @@
+#include "LinePotential.h"
+#include <cassert>
+#include <cstring>
+
+namespace colorlines {
+
+template <int Width, int Height>
+LinePotential<Width, Height>::LinePotential(const Board<Width, Height>* gameGrid) : m_gameGrid(gameGrid) {
+    assert(m_gameGrid != nullptr);
+    rebuild();
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::rebuild() {
+    const Table& table = LINE_WINDOWS<Width, Height, LENGTH>;
+    std::memset(m_histogram, 0, sizeof(m_histogram));
+    std::memset(m_open, 0, sizeof(m_open));
+    std::memset(m_openTotal, 0, sizeof(m_openTotal));
+    for (int window = 0; window < WINDOW_COUNT; ++window) {
+        for (int cell : table.windows[window].cells) {
+            ++m_histogram[window][static_cast<int>(m_gameGrid->getColor(cell))];
+        }
+        countWindow(window, 1);
+    }
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::cellChanged(int index, BallColor oldColor) {
+    BallColor newColor = m_gameGrid->getColor(index);
+    if (newColor == oldColor) {
+        return;
+    }
+    const Table& table = LINE_WINDOWS<Width, Height, LENGTH>;
+    const uint16_t* windows = table.windowsThrough(index);
+    for (int i = 0; i < table.windowCountThrough(index); ++i) {
+        int window = windows[i];
+        countWindow(window, -1);
+        --m_histogram[window][static_cast<int>(oldColor)];
+        ++m_histogram[window][static_cast<int>(newColor)];
+        countWindow(window, 1);
+    }
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::cellsChanged(Bitboard cells) {
+    const Table& table = LINE_WINDOWS<Width, Height, LENGTH>;
+    bool refreshed[WINDOW_COUNT] = {}; // Windows shared by several changed cells are recounted once
+    while (cells.any()) {
+        int index = cells.popLowestBit();
+        const uint16_t* windows = table.windowsThrough(index);
+        for (int i = 0; i < table.windowCountThrough(index); ++i) {
+            int window = windows[i];
+            if (!refreshed[window]) {
+                refreshed[window] = true;
+                refreshWindow(window);
+            }
+        }
+    }
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::apply(const TurnResult& turn) {
+    // Cleared cells and spawns that were cleared again are now empty, with no record of
+    // their colour, so every touched window is recounted rather than patched
+    Bitboard changed = turn.cleared | turn.spawnCleared;
+    if (turn.from >= 0) {
+        changed |= Bitboard::bit(turn.from) | Bitboard::bit(turn.to);
+    }
+    for (int i = 0; i < turn.spawnCount; ++i) {
+        changed |= Bitboard::bit(turn.spawnCells[i]);
+    }
+    cellsChanged(changed);
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::refreshWindow(int window) {
+    const Table& table = LINE_WINDOWS<Width, Height, LENGTH>;
+    countWindow(window, -1);
+    std::memset(m_histogram[window], 0, sizeof(m_histogram[window]));
+    for (int cell : table.windows[window].cells) {
+        ++m_histogram[window][static_cast<int>(m_gameGrid->getColor(cell))];
+    }
+    countWindow(window, 1);
+}
+
+template <int Width, int Height>
+void LinePotential<Width, Height>::countWindow(int window, int delta) {
+    const uint8_t* histogram = m_histogram[window];
+    int balls = LENGTH - histogram[static_cast<int>(BallColor::EMPTY)];
+    if (balls == 0) {
+        return;
+    }
+    // Open iff one colour accounts for every ball in the window
+    for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+        if (histogram[color] == balls) {
+            m_open[color][balls] += delta;
+            m_openTotal[balls] += delta;
+            return;
+        }
+        if (histogram[color] != 0) {
+            return; // Another colour is present too
+        }
+    }
+}
+
+template <int Width, int Height>
+bool LinePotential<Width, Height>::isConsistent() const {
+    LinePotential fresh(m_gameGrid);
+    return std::memcmp(m_histogram, fresh.m_histogram, sizeof(m_histogram)) == 0 &&
+           std::memcmp(m_open, fresh.m_open, sizeof(m_open)) == 0 &&
+           std::memcmp(m_openTotal, fresh.m_openTotal, sizeof(m_openTotal)) == 0;
+}
+
+template class LinePotential<7, 7>;
+template class LinePotential<9, 9>;
+template class LinePotential<11, 11>;
+
+} // namespace colorlines
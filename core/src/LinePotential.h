@@ -0,0 +1,65 @@
+#ifndef COLORLINES_LINEPOTENTIAL_H
+#define COLORLINES_LINEPOTENTIAL_H
+
+#include "GameGrid.h"
+#include "LineWindows.h"
+#include "TurnResolver.h"
+#include <cstdint>
+
+namespace colorlines {
+
+// Incremental count of "open" windows for evaluation: a window of five cells is open for
+// a colour when it holds k >= 1 balls of that colour and nothing else, so it could still
+// become a line. Keeps a colour histogram per window (LINE_WINDOWS) and, for every colour
+// and k, how many windows are open with k balls. A changed cell only touches the windows
+// through it (at most 20 on 9x9), and the totals are read in O(1).
+//
+// The tracker watches a Board like Solver does. After a TurnResolver turn, apply() its
+// TurnResult; single edits are reported with cellChanged() or cellsChanged(), and bulk
+// changes (reset, load) with rebuild().
+template <int Width, int Height>
+class LinePotential {
+public:
+    static const int LENGTH = 5;
+
+    LinePotential(const Board<Width, Height>* gameGrid);
+
+    // Recomputes everything from the board.
+    void rebuild();
+    // The board's cell 'index' used to hold 'oldColor'; its current colour is read from the board.
+    void cellChanged(int index, BallColor oldColor);
+    // Cells in 'cells' may have changed; their windows are recounted from the board.
+    void cellsChanged(Bitboard cells);
+    // Catches up with every cell a resolved turn touched: the move, spawns and clears.
+    void apply(const TurnResult& turn);
+
+    // Windows open for 'color' with exactly 'balls' of it (1 <= balls <= LENGTH).
+    int getOpenCount(BallColor color, int balls) const { return m_open[static_cast<int>(color)][balls]; }
+    // The same summed over all colours.
+    int getOpenCount(int balls) const { return m_openTotal[balls]; }
+
+    // True if the incremental counts match a full recomputation from the board.
+    bool isConsistent() const;
+
+private:
+    using Table = LineWindowTable<Width, Height, LENGTH>;
+    static constexpr int WINDOW_COUNT = Table::WINDOW_COUNT;
+
+    // Adds 'delta' to the open count the window currently contributes to, if any.
+    void countWindow(int window, int delta);
+    // Recounts one window's histogram from the board.
+    void refreshWindow(int window);
+
+    const Board<Width, Height>* m_gameGrid;
+    uint8_t m_histogram[WINDOW_COUNT][BALL_COLOR_COUNT]; // Cells of each colour (EMPTY included) per window
+    int m_open[BALL_COLOR_COUNT][LENGTH + 1];            // [colour][balls]; the EMPTY row stays 0
+    int m_openTotal[LENGTH + 1];
+};
+
+extern template class LinePotential<7, 7>;
+extern template class LinePotential<9, 9>;
+extern template class LinePotential<11, 11>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_LINEPOTENTIAL_H
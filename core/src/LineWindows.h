@@ -0,0 +1,85 @@
+#ifndef COLORLINES_LINEWINDOWS_H
+#define COLORLINES_LINEWINDOWS_H
+
+#include "Bitboard.h"
+#include "LineDetector.h"
+#include <array>
+#include <cstdint>
+
+namespace colorlines {
+
+// Every straight window of 'Length' cells on a Width x Height board (rows, columns and
+// both diagonals), plus for each cell the windows that contain it. The set only depends
+// on the dimensions, so it is built at compile time: code reacting to a changed cell
+// (solver, evaluation, spawn-risk analysis) loops over that cell's windows instead of
+// walking directions with bounds checks.
+template <int Width, int Height, int Length>
+struct LineWindowTable {
+    static_assert(Width > 0 && Height > 0 && Width * Height <= Bitboard::BITS, "Board does not fit in a Bitboard");
+    static_assert(Length > 0, "Windows need at least one cell");
+
+    static constexpr int CELL_COUNT = Width * Height;
+    static constexpr int RUNS_ACROSS = Width >= Length ? Width - Length + 1 : 0; // Window starts per row
+    static constexpr int RUNS_DOWN = Height >= Length ? Height - Length + 1 : 0; // Window starts per column
+    static constexpr int WINDOW_COUNT = Height * RUNS_ACROSS + Width * RUNS_DOWN + 2 * RUNS_ACROSS * RUNS_DOWN;
+    static constexpr int MAX_WINDOWS_PER_CELL = 4 * Length; // Length windows per direction
+
+    struct Window {
+        Bitboard mask;                     // All cells of the window
+        uint8_t cells[Length];             // Cell indices (r * Width + c), in step order
+        LineDetector::Direction direction;
+    };
+
+    std::array<Window, WINDOW_COUNT> windows;
+    std::array<uint8_t, CELL_COUNT> cellWindowCount;
+    std::array<std::array<uint16_t, MAX_WINDOWS_PER_CELL>, CELL_COUNT> cellWindows; // Indices into 'windows'
+
+    // Windows containing 'cell': cellWindows[cell][0 .. cellWindowCount[cell]).
+    constexpr const uint16_t* windowsThrough(int cell) const { return cellWindows[cell].data(); }
+    constexpr int windowCountThrough(int cell) const { return cellWindowCount[cell]; }
+};
+
+template <int Width, int Height, int Length>
+constexpr LineWindowTable<Width, Height, Length> makeLineWindowTable() {
+    using Table = LineWindowTable<Width, Height, Length>;
+    // Start cell ranges and steps per direction; same order as LineDetector::Direction
+    struct Scan { int firstRow, lastRow, firstCol, lastCol, dr, dc; };
+    const Scan scans[LineDetector::DIRECTION_COUNT] = {
+        {0, Height - 1, 0, Width - Length, 0, 1},               // HORIZONTAL
+        {0, Height - Length, 0, Width - 1, 1, 0},               // VERTICAL
+        {0, Height - Length, 0, Width - Length, 1, 1},          // DIAGONAL (down-right)
+        {0, Height - Length, Length - 1, Width - 1, 1, -1},     // ANTI_DIAGONAL (down-left)
+    };
+
+    Table table{};
+    int windowIndex = 0;
+    for (int d = 0; d < LineDetector::DIRECTION_COUNT; ++d) {
+        const Scan& scan = scans[d];
+        for (int r = scan.firstRow; r <= scan.lastRow; ++r) {
+            for (int c = scan.firstCol; c <= scan.lastCol; ++c) {
+                typename Table::Window& window = table.windows[windowIndex];
+                window.direction = static_cast<LineDetector::Direction>(d);
+                for (int k = 0; k < Length; ++k) {
+                    int cell = (r + k * scan.dr) * Width + (c + k * scan.dc);
+                    window.cells[k] = static_cast<uint8_t>(cell);
+                    window.mask = window.mask | Bitboard::bit(cell);
+                    table.cellWindows[cell][table.cellWindowCount[cell]++] = static_cast<uint16_t>(windowIndex);
+                }
+                ++windowIndex;
+            }
+        }
+    }
+    return table;
+}
+
+// Tables are built on first use for any size; each one is a compile-time constant.
+template <int Width, int Height, int Length>
+inline constexpr LineWindowTable<Width, Height, Length> LINE_WINDOWS = makeLineWindowTable<Width, Height, Length>();
+
+// The classic board: 140 windows of five, at most 20 through any cell.
+inline constexpr const LineWindowTable<9, 9, 5>& LINE_WINDOWS_9X9 = LINE_WINDOWS<9, 9, 5>;
+static_assert(LineWindowTable<9, 9, 5>::WINDOW_COUNT == 140, "9x9 board has 140 windows of five");
+
+} // namespace colorlines
+
+#endif //COLORLINES_LINEWINDOWS_H
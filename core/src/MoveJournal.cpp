@@ -0,0 +1,108 @@
+#include "MoveJournal.h"
+
+namespace colorlines {
+
+template <int Width, int Height>
+MoveJournal<Width, Height>::MoveJournal(Board<Width, Height>* gameGrid) : m_gameGrid(gameGrid) {}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::beginTurn(int score) {
+    m_turns.push_back({m_gameGrid->getRngState(), score, static_cast<int>(m_changes.size())});
+}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::placeBall(int r, int c, BallColor color) {
+    if (color == BallColor::EMPTY) {
+        return;
+    }
+    // Log a replaced ball as its own removal so the placement delta is always "was EMPTY"
+    removeBall(r, c);
+    m_gameGrid->placeBall(r, c, color);
+    logPlacement(m_gameGrid->cellIndex(r, c));
+}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::logPlacement(int index) {
+    // Right after a placement the board still reports the cell's old empty-list slot
+    m_changes.push_back({static_cast<uint8_t>(index), static_cast<uint8_t>(BallColor::EMPTY),
+                         static_cast<uint8_t>(m_gameGrid->getEmptySlot(index))});
+}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::removeBall(int r, int c) {
+    BallColor color = m_gameGrid->getBall(r, c).getColor();
+    if (color == BallColor::EMPTY) {
+        return;
+    }
+    m_gameGrid->removeBall(r, c);
+    m_changes.push_back({static_cast<uint8_t>(m_gameGrid->cellIndex(r, c)),
+                         static_cast<uint8_t>(color), 0});
+}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::moveBall(int fromR, int fromC, int toR, int toC) {
+    BallColor color = m_gameGrid->getBall(fromR, fromC).getColor();
+    removeBall(fromR, fromC);
+    placeBall(toR, toC, color);
+}
+
+template <int Width, int Height>
+std::vector<std::pair<int, int>> MoveJournal<Width, Height>::addRandomBalls(int count) {
+    std::vector<std::pair<int, int>> added = m_gameGrid->addRandomBalls(count);
+    for (const auto& cell : added) {
+        logPlacement(m_gameGrid->cellIndex(cell.first, cell.second));
+    }
+    return added;
+}
+
+template <int Width, int Height>
+std::pair<int, int> MoveJournal<Width, Height>::placeRandomBall(BallColor color) {
+    std::pair<int, int> cell = m_gameGrid->placeRandomBall(color);
+    if (cell.first >= 0) {
+        logPlacement(m_gameGrid->cellIndex(cell.first, cell.second));
+    }
+    return cell;
+}
+
+template <int Width, int Height>
+bool MoveJournal<Width, Height>::canUndo() const {
+    return !m_turns.empty();
+}
+
+template <int Width, int Height>
+int MoveJournal<Width, Height>::undoTurn() {
+    if (m_turns.empty()) {
+        return 0;
+    }
+    const TurnRecord turn = m_turns.back();
+    m_turns.pop_back();
+
+    int width = m_gameGrid->getWidth();
+    while (static_cast<int>(m_changes.size()) > turn.firstChange) {
+        CellChange change = m_changes.back();
+        m_changes.pop_back();
+        int r = change.index / width;
+        int c = change.index % width;
+        if (change.before == static_cast<uint8_t>(BallColor::EMPTY)) {
+            m_gameGrid->undoPlaceBall(r, c, change.slot);
+        } else {
+            // Re-adding the ball pops it off the end of the empty list, where removeBall put it
+            m_gameGrid->placeBall(r, c, static_cast<BallColor>(change.before));
+        }
+    }
+    m_gameGrid->setRngState(turn.rngState);
+    return turn.score;
+}
+
+template <int Width, int Height>
+void MoveJournal<Width, Height>::clear() {
+    m_changes.clear();
+    m_turns.clear();
+}
+
+template class MoveJournal<7, 7>;
+template class MoveJournal<9, 9>;
+template class MoveJournal<11, 11>;
+template class MoveJournal<>;
+
+} // namespace colorlines
@@ -0,0 +1,64 @@
+#ifndef COLORLINES_MOVEJOURNAL_H
+#define COLORLINES_MOVEJOURNAL_H
+
+#include "GameGrid.h"
+#include <cstdint>
+#include <vector>
+#include <utility> // For std::pair
+
+namespace colorlines {
+
+// Make/unmake journal for a Board. Every change made through the journal during a turn
+// (the move, line clears, spawns) is logged as a three-byte cell delta, and undoTurn()
+// replays the deltas backwards and restores the spawn RNG, leaving the board exactly as
+// it was, hash and empty-cell order included. Search can walk a game tree in place this
+// way instead of copying the board, and the GTK window uses it for its Undo button.
+// The logs keep their capacity, so after warm-up a make/unmake pair does not allocate.
+template <int Width = DYNAMIC_SIZE, int Height = DYNAMIC_SIZE>
+class MoveJournal {
+public:
+    MoveJournal(Board<Width, Height>* gameGrid);
+
+    // Starts a new turn record. 'score' is handed back by undoTurn().
+    void beginTurn(int score = 0);
+
+    // Journaled board edits; use these instead of the Board methods during a turn.
+    void moveBall(int fromR, int fromC, int toR, int toC);
+    void removeBall(int r, int c);
+    std::vector<std::pair<int, int>> addRandomBalls(int count);
+    // Board::placeRandomBall() through the journal; {-1, -1} if the board is full.
+    std::pair<int, int> placeRandomBall(BallColor color);
+
+    bool canUndo() const;
+    // Reverts the most recent turn and returns the score passed to its beginTurn().
+    int undoTurn();
+    void clear();
+
+private:
+    struct CellChange {
+        uint8_t index;  // Cell index on the board
+        uint8_t before; // BallColor before the change; EMPTY means a ball was placed
+        uint8_t slot;   // For placements: the cell's former slot in the empty-cell list
+    };
+    struct TurnRecord {
+        uint64_t rngState;
+        int score;
+        int firstChange; // Index of the turn's first entry in m_changes
+    };
+
+    Board<Width, Height>* m_gameGrid;
+    std::vector<CellChange> m_changes;
+    std::vector<TurnRecord> m_turns;
+
+    void placeBall(int r, int c, BallColor color);
+    void logPlacement(int index);
+};
+
+extern template class MoveJournal<7, 7>;
+extern template class MoveJournal<9, 9>;
+extern template class MoveJournal<11, 11>;
+extern template class MoveJournal<>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_MOVEJOURNAL_H
@@ -0,0 +1,69 @@
+#include "PackedBoard.h"
+#include <cassert>
+
+namespace colorlines {
+
+static_assert(BALL_COLOR_COUNT <= 16, "BallColor must fit in a nibble");
+
+namespace {
+
+// The word-at-a-time paths below read and write cells in little-endian order.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool WORD_PATH = false;
+#else
+const bool WORD_PATH = true;
+#endif
+
+} // namespace
+
+void packCells(const BallColor* cells, int count, unsigned char* packed) {
+    assert(count >= 0);
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(cells);
+    int i = 0;
+    if (WORD_PATH) {
+        // Eight one-byte cells -> four bytes: fold each odd byte into the high nibble of
+        // the even byte before it, then squeeze the even bytes together.
+        for (; i + 8 <= count; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, in + i, 8);
+            word = (word | (word >> 4)) & 0x00FF00FF00FF00FFULL;
+            word = (word | (word >> 8)) & 0x0000FFFF0000FFFFULL;
+            word = (word | (word >> 16)) & 0x00000000FFFFFFFFULL;
+            uint32_t half = static_cast<uint32_t>(word);
+            std::memcpy(packed + i / 2, &half, 4);
+        }
+    }
+    for (; i + 1 < count; i += 2) {
+        packed[i / 2] = static_cast<unsigned char>(in[i] | (in[i + 1] << 4));
+    }
+    if (i < count) {
+        packed[i / 2] = in[i];
+    }
+}
+
+void unpackCells(const unsigned char* packed, int count, BallColor* cells) {
+    assert(count >= 0);
+    unsigned char* out = reinterpret_cast<unsigned char*>(cells);
+    int i = 0;
+    if (WORD_PATH) {
+        // Four bytes -> eight one-byte cells, the inverse of the packCells steps.
+        for (; i + 8 <= count; i += 8) {
+            uint32_t half;
+            std::memcpy(&half, packed + i / 2, 4);
+            uint64_t word = half;
+            word = (word | (word << 16)) & 0x0000FFFF0000FFFFULL;
+            word = (word | (word << 8)) & 0x00FF00FF00FF00FFULL;
+            word = (word | (word << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            std::memcpy(out + i, &word, 8);
+        }
+    }
+    for (; i + 1 < count; i += 2) {
+        out[i] = packed[i / 2] & 0xF;
+        out[i + 1] = packed[i / 2] >> 4;
+    }
+    if (i < count) {
+        out[i] = packed[i / 2] & 0xF;
+    }
+}
+
+} // namespace colorlines
@@ -0,0 +1,82 @@
+#ifndef COLORLINES_PACKEDBOARD_H
+#define COLORLINES_PACKEDBOARD_H
+
+#include "GameGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace colorlines {
+
+// 4-bit cell codec. Cell 2i goes in the low nibble of byte i and cell 2i+1 in the high
+// nibble, so 'count' cells take (count + 1) / 2 bytes; an odd count leaves the last high
+// nibble zero. Both routines work eight cells per step in a 64-bit register.
+void packCells(const BallColor* cells, int count, unsigned char* packed);
+void unpackCells(const unsigned char* packed, int count, BallColor* cells);
+
+// Canonical packed encoding of a fixed-size board's cell colours: 41 bytes for 9x9.
+// Equal positions have identical bytes, so a PackedBoard works as a hash-map key
+// (with PackedBoard::Hash) and can be written to disk as is (sizeof == BYTE_COUNT).
+// Spawn RNG state, score and other metadata are not part of the encoding.
+template <int Width, int Height>
+class PackedBoard {
+    static_assert(Width > 0 && Height > 0, "PackedBoard needs a fixed board size");
+
+public:
+    static constexpr int CELL_COUNT = Width * Height;
+    static constexpr int BYTE_COUNT = (CELL_COUNT + 1) / 2;
+
+    PackedBoard() : m_bytes() {} // All cells empty
+    explicit PackedBoard(const Board<Width, Height>& board) {
+        BallColor cells[CELL_COUNT];
+        board.getCells(cells);
+        packCells(cells, CELL_COUNT, m_bytes);
+    }
+
+    // Rebuilds 'board' from the encoding. The board's spawn RNG is left untouched.
+    void unpack(Board<Width, Height>& board) const {
+        BallColor cells[CELL_COUNT];
+        unpackCells(m_bytes, CELL_COUNT, cells);
+        board.reset();
+        for (int index = 0; index < CELL_COUNT; ++index) {
+            if (cells[index] != BallColor::EMPTY) {
+                board.placeBall(index / Width, index % Width, cells[index]);
+            }
+        }
+    }
+
+    BallColor getColor(int index) const {
+        return static_cast<BallColor>((m_bytes[index >> 1] >> ((index & 1) * 4)) & 0xF);
+    }
+
+    const unsigned char* data() const { return m_bytes; }
+    unsigned char* data() { return m_bytes; }
+
+    bool operator==(const PackedBoard& other) const { return std::memcmp(m_bytes, other.m_bytes, BYTE_COUNT) == 0; }
+    bool operator!=(const PackedBoard& other) const { return !(*this == other); }
+
+    // Hash functor for std::unordered_map / std::unordered_set keys.
+    struct Hash {
+        std::size_t operator()(const PackedBoard& board) const {
+            uint64_t hash = 0;
+            int i = 0;
+            for (; i + 8 <= BYTE_COUNT; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, board.m_bytes + i, 8);
+                hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+                hash ^= hash >> 29;
+            }
+            for (; i < BYTE_COUNT; ++i) {
+                hash = (hash ^ board.m_bytes[i]) * 0x100000001B3ULL;
+            }
+            return static_cast<std::size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+private:
+    unsigned char m_bytes[BYTE_COUNT];
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_PACKEDBOARD_H
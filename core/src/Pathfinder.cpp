@@ -0,0 +1,50 @@
+#include "Pathfinder.h"
+#include <cassert>
+
+namespace colorlines {
+
+template <int Width, int Height>
+Pathfinder<Width, Height>::Pathfinder(const Board<Width, Height>* gameGrid)
+  : m_gameGrid(gameGrid), m_regions(gameGrid) {
+    assert(m_gameGrid != nullptr); // EmptyRegions asserts it too, before reading the board
+}
+
+template <int Width, int Height>
+bool Pathfinder<Width, Height>::canReach(int startR, int startC, int endR, int endC) {
+    if (startR == endR && startC == endC) {
+        return true; // Already at the destination
+    }
+
+    int height = m_gameGrid->getHeight();
+    int width = m_gameGrid->getWidth();
+
+    // Boundary checks for start and end points
+    if (startR < 0 || startR >= height || startC < 0 || startC >= width ||
+        endR < 0 || endR >= height || endC < 0 || endC >= width) {
+        return false;
+    }
+
+    // The start cell holds the ball and the destination is checked for emptiness by the
+    // caller, so only the cells in between must be empty: the ball reaches the empty
+    // regions next to it, and any cell adjacent to those (or to the ball itself).
+    int start = m_gameGrid->cellIndex(startR, startC);
+    Bitboard reached = Bitboard::bit(start) | m_regions.reachableFrom(start);
+    return m_regions.neighbours(reached).test(m_gameGrid->cellIndex(endR, endC));
+}
+
+template <int Width, int Height>
+Bitboard Pathfinder<Width, Height>::getReachableCells(int startR, int startC) {
+    if (startR < 0 || startR >= m_gameGrid->getHeight() || startC < 0 ||
+        startC >= m_gameGrid->getWidth()) {
+        return Bitboard();
+    }
+    int start = m_gameGrid->cellIndex(startR, startC);
+    return m_regions.reachableFrom(start) & ~Bitboard::bit(start); // An empty start is not a destination
+}
+
+template class Pathfinder<7, 7>;
+template class Pathfinder<9, 9>;
+template class Pathfinder<11, 11>;
+template class Pathfinder<>;
+
+} // namespace colorlines
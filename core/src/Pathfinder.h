@@ -0,0 +1,36 @@
+#ifndef COLORLINES_PATHFINDER_H
+#define COLORLINES_PATHFINDER_H
+
+#include "Bitboard.h"
+#include "EmptyRegions.h"
+#include "GameGrid.h"
+
+namespace colorlines {
+
+// Reachability on a Board of the same dimensions (Pathfinder<> for the runtime-sized GameGrid).
+// Empty cells are labelled into connected regions once per position (EmptyRegions), so a
+// query against an unchanged board is a few mask lookups, and nothing is allocated.
+template <int Width = DYNAMIC_SIZE, int Height = DYNAMIC_SIZE>
+class Pathfinder {
+public:
+    // 'gameGrid' must not be null; the regions are tied to it from construction.
+    Pathfinder(const Board<Width, Height>* gameGrid);
+
+    bool canReach(int startR, int startC, int endR, int endC);
+    // Every empty cell the ball on (startR, startC) can move to, in one lookup; replaces
+    // a canReach() per target when highlighting or enumerating moves.
+    Bitboard getReachableCells(int startR, int startC);
+
+private:
+    const Board<Width, Height>* m_gameGrid;
+    EmptyRegions<Width, Height> m_regions; // Relabelled whenever the board's empty cells change
+};
+
+extern template class Pathfinder<7, 7>;
+extern template class Pathfinder<9, 9>;
+extern template class Pathfinder<11, 11>;
+extern template class Pathfinder<>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_PATHFINDER_H
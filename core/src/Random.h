@@ -0,0 +1,36 @@
+#ifndef COLORLINES_RANDOM_H
+#define COLORLINES_RANDOM_H
+
+#include <cstdint>
+
+namespace colorlines {
+
+// SplitMix64 generator. Its whole state is one 64-bit word, so a board can be copied
+// or its RNG position saved and restored (see MoveJournal) for the cost of a uint64_t.
+// Satisfies UniformRandomBitGenerator, so it works with the <random> distributions.
+class SplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed = 0) : m_state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t getState() const { return m_state; }
+    void setState(uint64_t state) { m_state = state; }
+
+private:
+    uint64_t m_state;
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_RANDOM_H
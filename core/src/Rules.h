@@ -0,0 +1,115 @@
+#ifndef COLORLINES_RULES_H
+#define COLORLINES_RULES_H
+
+#include "Bitboard.h"
+#include "GameGrid.h"
+#include "LineDetector.h"
+#include "Scoring.h"
+
+namespace colorlines {
+
+// Rulesets as compile-time policies. A Ruleset fixes the minimum line length, which
+// directions count, how a cleared line scores and what lines completed by spawned balls
+// are worth; RuleEngine then finds lines with every loop bound, shift and edge guard a
+// constant, so each ruleset gets its own fully inlined shift-and-mask path.
+
+// Direction sets, one bit per LineDetector::Direction.
+constexpr unsigned directionBit(LineDetector::Direction direction) { return 1u << direction; }
+constexpr unsigned ORTHOGONAL_DIRECTIONS =
+    directionBit(LineDetector::HORIZONTAL) | directionBit(LineDetector::VERTICAL);
+constexpr unsigned ALL_DIRECTIONS = ORTHOGONAL_DIRECTIONS | directionBit(LineDetector::DIAGONAL) |
+                                    directionBit(LineDetector::ANTI_DIAGONAL);
+
+// Points for the balls a player's move cleared (all its lines together).
+struct FlatLineScoring {
+    static constexpr int score(int balls) { return Scoring::flatLineScore(balls); }
+};
+struct QuadraticLineScoring {
+    static constexpr int score(int balls) { return Scoring::quadraticLineScore(balls); }
+};
+
+// Points for the balls cleared by lines that spawned balls completed.
+struct NoSpawnScoring {
+    static constexpr int score(int) { return 0; }
+};
+template <int PointsPerBall>
+struct PerBallSpawnScoring {
+    static constexpr int score(int balls) { return balls * PointsPerBall; }
+};
+
+template <int MinLength, unsigned Directions, class LineScoring, class SpawnScoring>
+struct Ruleset {
+    static_assert(MinLength >= 2, "A line needs at least two balls");
+    static_assert(Directions != 0 && (Directions & ~ALL_DIRECTIONS) == 0, "Unknown direction bits");
+
+    static constexpr int MIN_LENGTH = MinLength;
+    static constexpr unsigned DIRECTIONS = Directions;
+    using LineScore = LineScoring;
+    using SpawnScore = SpawnScoring;
+};
+
+// The GTK frontend's rules: lines of five in any direction, 10 points plus 5 per extra
+// ball, spawned lines clear for free.
+using FlatRules = Ruleset<5, ALL_DIRECTIONS, FlatLineScoring, NoSpawnScoring>;
+// The Qt frontend's rules: lines of five in any direction, quadratic bonus, one point per
+// ball cleared by a spawned line.
+using QuadraticRules = Ruleset<5, ALL_DIRECTIONS, QuadraticLineScoring,
+                               PerBallSpawnScoring<Scoring::SPAWN_CLEAR_POINTS_PER_BALL>>;
+
+template <class Rules, int Width, int Height>
+class RuleEngine {
+    static_assert(Width > 0 && Height > 0 && Width * Height <= Bitboard::BITS, "Board does not fit in a Bitboard");
+
+public:
+    using BoardType = Board<Width, Height>;
+
+    // Cells on lines of the ruleset, on the whole board.
+    static Bitboard findLines(const BoardType& board) { return findLinesFrom(board, Bitboard(), false); }
+
+    // Cells on lines that contain at least one cell of 'changed' (the moved ball, the
+    // spawned balls). Lines elsewhere on the board are left alone.
+    static Bitboard findLinesThrough(const BoardType& board, const Bitboard& changed) {
+        return findLinesFrom(board, changed, true);
+    }
+
+    static constexpr int moveScore(int balls) { return Rules::LineScore::score(balls); }
+    static constexpr int spawnScore(int balls) { return Rules::SpawnScore::score(balls); }
+
+private:
+    static constexpr int LONGEST_RUN = Width > Height ? Width : Height;
+
+    static Bitboard findLinesFrom(const BoardType& board, const Bitboard& seeds, bool fromSeeds) {
+        return directionLines<LineDetector::HORIZONTAL>(board, seeds, fromSeeds) |
+               directionLines<LineDetector::VERTICAL>(board, seeds, fromSeeds) |
+               directionLines<LineDetector::DIAGONAL>(board, seeds, fromSeeds) |
+               directionLines<LineDetector::ANTI_DIAGONAL>(board, seeds, fromSeeds);
+    }
+
+    // One direction per instantiation, so the shift is an immediate and the guard a constant.
+    template <int Direction>
+    static Bitboard directionLines(const BoardType& board, const Bitboard& seeds, bool fromSeeds) {
+        if constexpr (!(Rules::DIRECTIONS & (1u << Direction))) {
+            return Bitboard();
+        } else {
+            constexpr int STEP = LineDetector::directionShift(Width, LineDetector::Direction(Direction));
+            constexpr Bitboard GUARD = LineDetector::directionGuard(Width, Height, LineDetector::Direction(Direction));
+            Bitboard pairs = LineDetector::samePairs(board.getColorMasks(), BALL_COLOR_COUNT, STEP) & GUARD;
+            Bitboard runs = LineDetector::runsFromPairs(pairs, STEP, Rules::MIN_LENGTH);
+            if (!fromSeeds) {
+                return runs;
+            }
+
+            // Grow from the seeds along same-colour pairs only, so a run of another colour
+            // that happens to touch this one is not picked up
+            Bitboard run = seeds & runs;
+            for (int k = 1; k < LONGEST_RUN && run.any(); ++k) {
+                run |= ((run & pairs) << STEP) | ((run >> STEP) & pairs);
+            }
+            return run;
+        }
+    }
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_RULES_H
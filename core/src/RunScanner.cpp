@@ -0,0 +1,249 @@
+#include "RunScanner.h"
+#include <algorithm> // For std::min
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COLORLINES_X86 1
+#include <immintrin.h>
+#endif
+
+namespace colorlines {
+
+namespace {
+
+// Portable kernels; also used for the tails of the vector kernels.
+
+void equalNonEmptyScalar(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = (a[i] != 0 && a[i] == b[i]) ? 0xFF : 0;
+    }
+}
+
+void andForwardScalar(uint8_t* data, size_t offset, size_t n) {
+    size_t limit = offset < n ? n - offset : 0;
+    for (size_t i = 0; i < limit; ++i) {
+        data[i] &= data[i + offset];
+    }
+    std::memset(data + limit, 0, n - limit); // Runs would continue off the end of the board
+}
+
+void orBackwardScalar(uint8_t* data, size_t offset, size_t n) {
+    for (size_t i = n; i-- > offset;) {
+        data[i] |= data[i - offset];
+    }
+}
+
+void orIntoScalar(uint8_t* dst, const uint8_t* src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+#ifdef COLORLINES_X86
+
+// SSE2: 16 cells per step. Part of the x86-64 baseline, so no target attribute is needed.
+
+void equalNonEmptySse2(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i same = _mm_cmpeq_epi8(va, vb);
+        __m128i empty = _mm_cmpeq_epi8(va, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_andnot_si128(empty, same));
+    }
+    equalNonEmptyScalar(a + i, b + i, out + i, n - i);
+}
+
+void andForwardSse2(uint8_t* data, size_t offset, size_t n) {
+    size_t limit = offset < n ? n - offset : 0;
+    size_t i = 0;
+    for (; i + 16 <= limit; i += 16) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + offset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_and_si128(value, next));
+    }
+    for (; i < limit; ++i) {
+        data[i] &= data[i + offset];
+    }
+    std::memset(data + limit, 0, n - limit);
+}
+
+void orBackwardSse2(uint8_t* data, size_t offset, size_t n) {
+    size_t end = n;
+    for (; end >= offset + 16; end -= 16) {
+        uint8_t* chunk = data + end - 16;
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
+        __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk - offset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(chunk), _mm_or_si128(value, previous));
+    }
+    orBackwardScalar(data, offset, end);
+}
+
+void orIntoSse2(uint8_t* dst, const uint8_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(d, s));
+    }
+    orIntoScalar(dst + i, src + i, n - i);
+}
+
+// AVX2: 32 cells per step. Compiled for AVX2 regardless of the global flags and only
+// called after a runtime CPU check.
+
+__attribute__((target("avx2")))
+void equalNonEmptyAvx2(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i same = _mm256_cmpeq_epi8(va, vb);
+        __m256i empty = _mm256_cmpeq_epi8(va, zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_andnot_si256(empty, same));
+    }
+    equalNonEmptyScalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void andForwardAvx2(uint8_t* data, size_t offset, size_t n) {
+    size_t limit = offset < n ? n - offset : 0;
+    size_t i = 0;
+    for (; i + 32 <= limit; i += 32) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_and_si256(value, next));
+    }
+    for (; i < limit; ++i) {
+        data[i] &= data[i + offset];
+    }
+    std::memset(data + limit, 0, n - limit);
+}
+
+__attribute__((target("avx2")))
+void orBackwardAvx2(uint8_t* data, size_t offset, size_t n) {
+    size_t end = n;
+    for (; end >= offset + 32; end -= 32) {
+        uint8_t* chunk = data + end - 32;
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+        __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk - offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(chunk), _mm256_or_si256(value, previous));
+    }
+    orBackwardScalar(data, offset, end);
+}
+
+__attribute__((target("avx2")))
+void orIntoAvx2(uint8_t* dst, const uint8_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(d, s));
+    }
+    orIntoScalar(dst + i, src + i, n - i);
+}
+
+#endif // COLORLINES_X86
+
+} // namespace
+
+RunScanner::RunScanner(Kernel kernel) {
+    if (kernel == AUTO || !isSupported(kernel)) {
+        kernel = isSupported(AVX2) ? AVX2 : isSupported(SSE2) ? SSE2 : SCALAR;
+    }
+    m_kernel = kernel;
+    m_kernels = &kernelsFor(kernel);
+}
+
+bool RunScanner::isSupported(Kernel kernel) {
+    switch (kernel) {
+    case AUTO:
+    case SCALAR:
+        return true;
+#ifdef COLORLINES_X86
+    case SSE2:
+        return __builtin_cpu_supports("sse2");
+    case AVX2:
+        return __builtin_cpu_supports("avx2");
+#else
+    case SSE2:
+    case AVX2:
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char* RunScanner::getKernelName() const {
+    switch (m_kernel) {
+    case SSE2: return "sse2";
+    case AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+const RunScanner::Kernels& RunScanner::kernelsFor(Kernel kernel) {
+    static const Kernels scalar = {equalNonEmptyScalar, andForwardScalar, orBackwardScalar, orIntoScalar};
+#ifdef COLORLINES_X86
+    static const Kernels sse2 = {equalNonEmptySse2, andForwardSse2, orBackwardSse2, orIntoSse2};
+    static const Kernels avx2 = {equalNonEmptyAvx2, andForwardAvx2, orBackwardAvx2, orIntoAvx2};
+    if (kernel == AVX2) return avx2;
+    if (kernel == SSE2) return sse2;
+#endif
+    (void)kernel;
+    return scalar;
+}
+
+void RunScanner::scan(const BallColor* cells, int width, int height, int minLength, uint8_t* clearMask) {
+    assert(width > 0 && height > 0 && minLength >= 1);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(cells);
+    size_t count = size_t(width) * size_t(height);
+
+    if (minLength == 1) {
+        m_kernels->equalNonEmpty(bytes, bytes, clearMask, count); // Every ball is a line
+        return;
+    }
+
+    std::memset(clearMask, 0, count);
+    m_runs.resize(count);
+    uint8_t* runs = m_runs.data();
+
+    // Right, down, down-right and down-left: the next cell is always at a higher index
+    static const int STEPS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& step : STEPS) {
+        size_t offset = size_t(step[0]) * size_t(width) + step[1];
+
+        // runs[i]: cell i and its next cell hold the same colour. Cells whose next cell is
+        // off the board (last rows, and the edge column for sideways steps) get 0.
+        size_t pairs = offset < count ? count - offset : 0;
+        m_kernels->equalNonEmpty(bytes, bytes + offset, runs, pairs);
+        std::memset(runs + pairs, 0, count - pairs);
+        if (step[1] != 0) {
+            int edgeColumn = step[1] > 0 ? width - 1 : 0;
+            for (int r = 0; r < height; ++r) {
+                runs[size_t(r) * width + edgeColumn] = 0;
+            }
+        }
+
+        // Keep cells starting minLength - 1 matching pairs in a row, i.e. a run of minLength.
+        // A zeroed edge cell inside the window clears it, so runs never wrap between rows.
+        for (int covered = 1; covered < minLength - 1;) {
+            int stride = std::min(covered, minLength - 1 - covered);
+            m_kernels->andForward(runs, stride * offset, count);
+            covered += stride;
+        }
+        // Spread every start over the minLength cells of its run
+        for (int covered = 1; covered < minLength;) {
+            int stride = std::min(covered, minLength - covered);
+            m_kernels->orBackward(runs, stride * offset, count);
+            covered += stride;
+        }
+        m_kernels->orInto(clearMask, runs, count);
+    }
+}
+
+} // namespace colorlines
@@ -0,0 +1,54 @@
+#ifndef COLORLINES_RUNSCANNER_H
+#define COLORLINES_RUNSCANNER_H
+
+#include "Ball.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace colorlines {
+
+// Line detection for boards far larger than a Bitboard (the 512x512 to 4096x4096 "giant
+// board" variant). Cells are one BallColor byte each, row-major. For each direction the
+// scanner builds a byte mask of "same colour as the next cell", ANDs it with copies of
+// itself offset along the direction (doubling the covered length each pass) until only
+// starts of runs of at least minLength survive, then ORs the starts back out over their
+// runs. Every pass is a linear stream over whole rows, run 16 or 32 bytes at a time by an
+// SSE2 or AVX2 kernel chosen at runtime from the CPU's features.
+class RunScanner {
+public:
+    enum Kernel { AUTO, SCALAR, SSE2, AVX2 };
+
+    // AUTO picks the widest kernel the CPU supports; an unsupported request falls back the same way.
+    explicit RunScanner(Kernel kernel = AUTO);
+
+    static bool isSupported(Kernel kernel);
+    Kernel getKernel() const { return m_kernel; }
+    const char* getKernelName() const;
+
+    // Writes 0xFF to clearMask[i] for every cell on a run of at least minLength same-coloured
+    // balls (any direction) and 0x00 elsewhere. clearMask holds width * height bytes.
+    void scan(const BallColor* cells, int width, int height, int minLength, uint8_t* clearMask);
+
+private:
+    struct Kernels {
+        // out[i] = (a[i] != 0 && a[i] == b[i]) ? 0xFF : 0
+        void (*equalNonEmpty)(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t n);
+        // data[i] &= data[i + offset] for i < n - offset, ascending (reads only cells not yet written)
+        void (*andForward)(uint8_t* data, size_t offset, size_t n);
+        // data[i] |= data[i - offset] for i >= offset, descending (reads only cells not yet written)
+        void (*orBackward)(uint8_t* data, size_t offset, size_t n);
+        // dst[i] |= src[i]
+        void (*orInto)(uint8_t* dst, const uint8_t* src, size_t n);
+    };
+
+    static const Kernels& kernelsFor(Kernel kernel);
+
+    Kernel m_kernel;
+    const Kernels* m_kernels;
+    std::vector<uint8_t> m_runs; // Scratch mask for the direction being scanned
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_RUNSCANNER_H
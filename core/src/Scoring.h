@@ -0,0 +1,29 @@
+#ifndef COLORLINES_SCORING_H
+#define COLORLINES_SCORING_H
+
+namespace colorlines {
+
+// Line scoring formulas used by the frontends.
+namespace Scoring {
+
+// 10 points for five balls, 5 more for each additional ball (GTK frontend).
+constexpr int flatLineScore(int ballsInLine) {
+    if (ballsInLine < 5) return 0;
+    return 10 + (ballsInLine - 5) * 5;
+}
+
+// 2 points per ball plus a bonus growing with the square of the length (Qt frontend).
+constexpr int quadraticLineScore(int ballsInLine) {
+    int score = ballsInLine * 2;
+    if (ballsInLine >= 5) score += (ballsInLine - 4) * ballsInLine;
+    return score;
+}
+
+// Points per ball for lines completed by spawned balls rather than by the player (Qt frontend).
+const int SPAWN_CLEAR_POINTS_PER_BALL = 1;
+
+} // namespace Scoring
+
+} // namespace colorlines
+
+#endif //COLORLINES_SCORING_H
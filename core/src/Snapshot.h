@@ -0,0 +1,76 @@
+#ifndef COLORLINES_SNAPSHOT_H
+#define COLORLINES_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace colorlines {
+
+// Seqlock publication of a trivially copyable value (typically a Board) from one writer
+// thread to any number of reader threads. publish() never waits for readers, and read()
+// takes no lock: it copies the value and retries only if a publish overlapped the copy,
+// so the UI thread is never blocked by analysis threads.
+//
+// The value is stored as relaxed atomic words so concurrent copies are race-free.
+// Each publish bumps the version by one; the initial value is version 0.
+template <typename T>
+class Snapshot {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot needs a trivially copyable type");
+
+public:
+    Snapshot() : m_sequence(0) { storeWords(T()); }
+    explicit Snapshot(const T& value) : m_sequence(0) { storeWords(value); }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    // Writer side. Must only be called from one thread at a time.
+    void publish(const T& value) {
+        uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed); // Odd: publish in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Reader side. Copies the latest published value into 'out' (a caller-owned scratch
+    // object, so no T is constructed per read) and returns the version it belongs to.
+    uint64_t read(T& out) const {
+        uint64_t words[WORD_COUNT];
+        uint64_t before;
+        for (;;) {
+            before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) continue; // Writer is mid-publish
+            for (int i = 0; i < WORD_COUNT; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        std::memcpy(&out, words, sizeof(T));
+        return before / 2;
+    }
+
+    // Version of the latest completed publish; cheap to poll for changes.
+    uint64_t getVersion() const { return m_sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr int WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void storeWords(const T& value) {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> m_sequence; // Twice the version, odd while a publish is in progress
+    std::atomic<uint64_t> m_words[WORD_COUNT];
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_SNAPSHOT_H
@@ -0,0 +1,61 @@
+#include "Solver.h"
+#include <vector>
+
+namespace colorlines {
+
+template <int Width, int Height>
+Solver<Width, Height>::Solver(const Board<Width, Height>* gameGrid)
+  : m_gameGrid(gameGrid),
+    m_detector(gameGrid ? gameGrid->getWidth() : 1, gameGrid ? gameGrid->getHeight() : 1) {}
+
+template <int Width, int Height>
+Bitboard Solver<Width, Height>::findLineMask(int minLength) const {
+    if (!m_gameGrid) {
+        return Bitboard();
+    }
+    return m_detector.lineCells(m_gameGrid->getColorMasks(), BALL_COLOR_COUNT, minLength);
+}
+
+template <int Width, int Height>
+std::vector<std::pair<int, int>> Solver<Width, Height>::findLines(int minLength) {
+    return maskToCells(findLineMask(minLength));
+}
+
+template <int Width, int Height>
+std::vector<std::pair<int, int>> Solver<Width, Height>::findLinesThrough(
+        const std::vector<std::pair<int, int>>& cells, int minLength) const {
+    if (!m_gameGrid) {
+        return {};
+    }
+
+    Bitboard lineMask; // Deduplicates cells shared by several lines
+    for (const auto& cell : cells) {
+        int index = m_gameGrid->cellIndex(cell.first, cell.second);
+        BallColor color = m_gameGrid->getColor(index);
+        if (color == BallColor::EMPTY) {
+            continue;
+        }
+        lineMask |= m_detector.lineCellsThrough(m_gameGrid->getColorMask(color), index, minLength);
+    }
+    return maskToCells(lineMask);
+}
+
+template <int Width, int Height>
+std::vector<std::pair<int, int>> Solver<Width, Height>::maskToCells(Bitboard mask) const {
+    // Bit order is row-major, so the cells come out sorted by (row, col)
+    std::vector<std::pair<int, int>> cells;
+    cells.reserve(mask.count());
+    int width = m_gameGrid->getWidth();
+    while (mask.any()) {
+        int index = mask.popLowestBit();
+        cells.push_back({index / width, index % width});
+    }
+    return cells;
+}
+
+template class Solver<7, 7>;
+template class Solver<9, 9>;
+template class Solver<11, 11>;
+template class Solver<>;
+
+} // namespace colorlines
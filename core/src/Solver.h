@@ -0,0 +1,46 @@
+#ifndef COLORLINES_SOLVER_H
+#define COLORLINES_SOLVER_H
+
+#include "Bitboard.h"
+#include "GameGrid.h"
+#include "LineDetector.h"
+#include <vector>
+#include <utility> // For std::pair
+
+namespace colorlines {
+
+// Line finder for a Board of the same dimensions. Solver<9, 9> works on Board<9, 9>;
+// Solver<> works on the runtime-sized GameGrid.
+template <int Width = DYNAMIC_SIZE, int Height = DYNAMIC_SIZE>
+class Solver {
+public:
+    Solver(const Board<Width, Height>* gameGrid);
+
+    // Returns a vector of coordinates of all balls that are part of a line.
+    // minLength is the minimum number of same-colored balls to form a line.
+    std::vector<std::pair<int, int>> findLines(int minLength = 5);
+    // Same cells as a mask (bit r * width + c); allocation-free.
+    Bitboard findLineMask(int minLength = 5) const;
+
+    // Like findLines(), but only checks the four axes through the given cells (for example
+    // the moved ball, or the balls just spawned). Cost depends on the number of changed
+    // cells, not on the board size. Empty cells in the list are skipped.
+    std::vector<std::pair<int, int>> findLinesThrough(const std::vector<std::pair<int, int>>& cells,
+                                                      int minLength = 5) const;
+
+private:
+    const Board<Width, Height>* m_gameGrid;
+    LineDetector m_detector; // Shift-and-mask runs over the board's colour masks
+
+    // Converts a line mask to (row, col) pairs in row-major order.
+    std::vector<std::pair<int, int>> maskToCells(Bitboard mask) const;
+};
+
+extern template class Solver<7, 7>;
+extern template class Solver<9, 9>;
+extern template class Solver<11, 11>;
+extern template class Solver<>;
+
+} // namespace colorlines
+
+#endif //COLORLINES_SOLVER_H
@@ -0,0 +1,86 @@
+#include "ThreadPool.h"
+
+namespace colorlines {
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+    for (int worker = 1; worker < threadCount; ++worker) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_workers) {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(int taskCount, const std::function<void(int, int)>& task) {
+    if (taskCount <= 0) {
+        return;
+    }
+    if (m_workers.empty() || taskCount == 1) {
+        for (int index = 0; index < taskCount; ++index) {
+            task(index, 0);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask = 0;
+        m_busyWorkers = static_cast<int>(m_workers.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+        runTasks(worker);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0) {
+            m_finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks(int worker) {
+    for (;;) {
+        int index;
+        {
+            // Tasks are coarse (a tile each), so a lock per hand-out is cheap enough
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_nextTask == m_taskCount) {
+                return;
+            }
+            index = m_nextTask++;
+        }
+        (*m_task)(index, worker);
+    }
+}
+
+} // namespace colorlines
@@ -0,0 +1,50 @@
+#ifndef COLORLINES_THREADPOOL_H
+#define COLORLINES_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace colorlines {
+
+// Fixed set of worker threads for data-parallel loops. run() hands out task indices
+// 0 .. taskCount - 1 one at a time until none are left, with the calling thread working
+// alongside the pool, and returns when every task has finished. Workers sleep between
+// calls, so a pool can be kept for the lifetime of its owner.
+class ThreadPool {
+public:
+    // threadCount counts the calling thread; 0 means one per hardware thread.
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    // Calls task(index, worker) for every index; 'worker' is in [0, getThreadCount())
+    // and is unique among the threads running at the same time, for per-thread scratch.
+    // Only one run() may be in progress at a time.
+    void run(int taskCount, const std::function<void(int, int)>& task);
+
+private:
+    void workerLoop(int worker);
+    void runTasks(int worker);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;     // Workers wait here for a new generation
+    std::condition_variable m_finished; // run() waits here for the workers
+    const std::function<void(int, int)>* m_task = nullptr;
+    int m_taskCount = 0;
+    int m_nextTask = 0;
+    int m_busyWorkers = 0;
+    unsigned m_generation = 0; // Bumped by every run() so each worker joins it once
+    bool m_stopping = false;
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_THREADPOOL_H
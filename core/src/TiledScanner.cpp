@@ -0,0 +1,48 @@
+#include "TiledScanner.h"
+#include <algorithm> // For std::min, std::max
+#include <cassert>
+#include <cstring>
+
+namespace colorlines {
+
+TiledScanner::TiledScanner(int threadCount, RunScanner::Kernel kernel)
+  : m_pool(threadCount), m_bandMasks(m_pool.getThreadCount()) {
+    for (int worker = 0; worker < m_pool.getThreadCount(); ++worker) {
+        m_scanners.emplace_back(new RunScanner(kernel));
+    }
+}
+
+void TiledScanner::scan(const BallColor* cells, int width, int height, int minLength, uint8_t* clearMask) {
+    assert(width > 0 && height > 0 && minLength >= 1);
+    int halo = minLength - 1;
+
+    // Band height from the pool size: BANDS_PER_THREAD bands for every thread, unless that
+    // makes a band shorter than a few halos (the halo rows are scanned twice) or smaller
+    // than MIN_BAND_CELLS
+    int wanted = m_pool.getThreadCount() * BANDS_PER_THREAD;
+    int bandRows = (height + wanted - 1) / wanted;
+    bandRows = std::max(bandRows, std::max(4 * halo, MIN_BAND_CELLS / width));
+    bandRows = std::max(bandRows, 1);
+    int bandCount = (height + bandRows - 1) / bandRows;
+
+    if (bandCount == 1) {
+        m_scanners[0]->scan(cells, width, height, minLength, clearMask);
+        return;
+    }
+
+    m_pool.run(bandCount, [&](int band, int worker) {
+        int firstRow = band * bandRows;
+        int endRow = std::min(height, firstRow + bandRows);
+        int scanFirst = std::max(0, firstRow - halo);
+        int scanEnd = std::min(height, endRow + halo);
+
+        std::vector<uint8_t>& bandMask = m_bandMasks[worker];
+        bandMask.resize(size_t(scanEnd - scanFirst) * width);
+        m_scanners[worker]->scan(cells + size_t(scanFirst) * width, width, scanEnd - scanFirst, minLength,
+                                 bandMask.data());
+        std::memcpy(clearMask + size_t(firstRow) * width, bandMask.data() + size_t(firstRow - scanFirst) * width,
+                    size_t(endRow - firstRow) * width);
+    });
+}
+
+} // namespace colorlines
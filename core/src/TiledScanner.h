@@ -0,0 +1,42 @@
+#ifndef COLORLINES_TILEDSCANNER_H
+#define COLORLINES_TILEDSCANNER_H
+
+#include "Ball.h"
+#include "RunScanner.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace colorlines {
+
+// RunScanner spread over all cores for giant boards. The board is cut into bands of whole
+// rows; each band is scanned together with a halo of minLength - 1 rows above and below,
+// which holds every window of minLength cells that touches the band, so each band finds
+// exactly the line cells a scan of the whole board would. Every band then writes only its
+// own rows of the clear mask: nothing is merged twice and no thread writes another's rows.
+// Bands are contiguous in memory, so the scanners run on the caller's cells in place.
+class TiledScanner {
+public:
+    // threadCount as for ThreadPool; 0 uses every hardware thread.
+    explicit TiledScanner(int threadCount = 0, RunScanner::Kernel kernel = RunScanner::AUTO);
+
+    int getThreadCount() const { return m_pool.getThreadCount(); }
+
+    // Same contract and result as RunScanner::scan().
+    void scan(const BallColor* cells, int width, int height, int minLength, uint8_t* clearMask);
+
+private:
+    // Bands per thread, so threads that finish early pick up more work
+    static const int BANDS_PER_THREAD = 4;
+    // Floor on a band's size, so a band's task is still worth handing out
+    static const int MIN_BAND_CELLS = 1 << 12;
+
+    ThreadPool m_pool;
+    std::vector<std::unique_ptr<RunScanner>> m_scanners; // One per pool thread
+    std::vector<std::vector<uint8_t>> m_bandMasks;       // Band + halo clear mask per thread
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_TILEDSCANNER_H
@@ -0,0 +1,123 @@
+#ifndef COLORLINES_TURNRESOLVER_H
+#define COLORLINES_TURNRESOLVER_H
+
+#include "Bitboard.h"
+#include "GameGrid.h"
+#include "MoveJournal.h"
+#include "Rules.h"
+#include <cassert>
+#include <cstdint>
+
+namespace colorlines {
+
+// Everything a turn changed, for a frontend to apply to its own state (ball ids,
+// animations, labels) without looking at the board again.
+struct TurnResult {
+    static const int MAX_SPAWNS = 8;
+
+    int from = -1;               // Cell the moved ball left, or -1 for a spawn-only turn
+    int to = -1;                 // Cell it arrived at
+    Bitboard cleared;            // Balls removed by lines the move completed
+    int spawnCount = 0;          // Balls spawned (fewer than asked if the board filled up)
+    uint8_t spawnCells[MAX_SPAWNS] = {};
+    BallColor spawnColors[MAX_SPAWNS] = {};
+    Bitboard spawnCleared;       // Balls removed by lines the spawned balls completed
+    int score = 0;               // Points earned this turn under the ruleset
+    bool gameOver = false;       // No empty cell is left
+};
+
+// Plays whole turns under a Ruleset: move, clear the move's lines and score them; if
+// nothing cleared, spawn, clear the spawned balls' lines and score those; then decide
+// whether the game is over. Lines are only searched through the cells that changed and
+// the empty count is kept by the board, so nothing is rescanned along the way.
+// Edits go through 'journal' when one is given, so the turn can be undone.
+template <class Rules, int Width, int Height>
+class TurnResolver {
+public:
+    using Engine = RuleEngine<Rules, Width, Height>;
+
+    TurnResolver(Board<Width, Height>* gameGrid, MoveJournal<Width, Height>* journal = nullptr)
+      : m_gameGrid(gameGrid), m_journal(journal) {
+        assert(m_gameGrid != nullptr);
+    }
+
+    // Moves the ball on cell 'from' to the empty cell 'to' (reachability is the caller's
+    // job). If the move completes no line, spawns 'spawnCount' balls with the given
+    // colours, or colours drawn from the board's RNG when 'spawnColors' is null.
+    TurnResult playTurn(int from, int to, int spawnCount, const BallColor* spawnColors = nullptr) {
+        TurnResult result;
+        result.from = from;
+        result.to = to;
+        moveBall(from, to);
+        result.cleared = Engine::findLinesThrough(*m_gameGrid, Bitboard::bit(to));
+        if (result.cleared.any()) {
+            result.score = Engine::moveScore(removeBalls(result.cleared));
+        } else {
+            spawn(result, spawnCount, spawnColors);
+        }
+        result.gameOver = m_gameGrid->isFull();
+        return result;
+    }
+
+    // A turn without a move, e.g. the opening balls of a new game.
+    TurnResult spawnBalls(int spawnCount, const BallColor* spawnColors = nullptr) {
+        TurnResult result;
+        spawn(result, spawnCount, spawnColors);
+        result.gameOver = m_gameGrid->isFull();
+        return result;
+    }
+
+private:
+    void spawn(TurnResult& result, int spawnCount, const BallColor* spawnColors) {
+        assert(spawnCount <= TurnResult::MAX_SPAWNS);
+        Bitboard spawned;
+        for (int i = 0; i < spawnCount && !m_gameGrid->isFull(); ++i) {
+            BallColor color = spawnColors ? spawnColors[i] : m_gameGrid->randomColor();
+            std::pair<int, int> cell = m_journal ? m_journal->placeRandomBall(color)
+                                                 : m_gameGrid->placeRandomBall(color);
+            int index = m_gameGrid->cellIndex(cell.first, cell.second);
+            result.spawnCells[result.spawnCount] = static_cast<uint8_t>(index);
+            result.spawnColors[result.spawnCount] = color;
+            ++result.spawnCount;
+            spawned.set(index);
+        }
+        result.spawnCleared = Engine::findLinesThrough(*m_gameGrid, spawned);
+        if (result.spawnCleared.any()) {
+            result.score += Engine::spawnScore(removeBalls(result.spawnCleared));
+        }
+    }
+
+    void moveBall(int from, int to) {
+        int width = m_gameGrid->getWidth();
+        if (m_journal) {
+            m_journal->moveBall(from / width, from % width, to / width, to % width);
+            return;
+        }
+        BallColor color = m_gameGrid->getColor(from);
+        m_gameGrid->removeBall(from / width, from % width);
+        m_gameGrid->placeBall(to / width, to % width, color);
+    }
+
+    // Removes every ball in 'cells' and returns how many there were.
+    int removeBalls(Bitboard cells) {
+        int width = m_gameGrid->getWidth();
+        int count = 0;
+        while (cells.any()) {
+            int index = cells.popLowestBit();
+            if (m_journal) {
+                m_journal->removeBall(index / width, index % width);
+            } else {
+                m_gameGrid->removeBall(index / width, index % width);
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    Board<Width, Height>* m_gameGrid;
+    MoveJournal<Width, Height>* m_journal; // Optional
+};
+
+} // namespace colorlines
+
+#endif //COLORLINES_TURNRESOLVER_H
@@ -0,0 +1,62 @@
+#ifndef COLORLINES_ZOBRIST_H
+#define COLORLINES_ZOBRIST_H
+
+#include "Ball.h"
+#include "Bitboard.h"
+#include <cstdint>
+
+namespace colorlines {
+
+// Zobrist keys for 64-bit position hashes. A position's hash is the XOR of the key of
+// every occupied (cell, colour) pair, so placing or removing a ball is a single XOR.
+// Keys are fixed at compile time, so hashes are stable across runs and processes.
+namespace Zobrist {
+
+// Length of the upcoming-ball queue that can be folded into a hash.
+const int UPCOMING_SLOTS = 3;
+
+struct KeyTable {
+    uint64_t cell[BALL_COLOR_COUNT][Bitboard::BITS];       // EMPTY row stays zero
+    uint64_t upcoming[UPCOMING_SLOTS][BALL_COLOR_COUNT];   // EMPTY column stays zero
+};
+
+// SplitMix64 step, used only to fill the key table.
+constexpr uint64_t nextKey(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr KeyTable makeKeyTable() {
+    KeyTable table{};
+    uint64_t state = 0x5A0B21575EEDULL;
+    for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+        for (int index = 0; index < Bitboard::BITS; ++index) {
+            table.cell[color][index] = nextKey(state);
+        }
+    }
+    for (int slot = 0; slot < UPCOMING_SLOTS; ++slot) {
+        for (int color = 1; color < BALL_COLOR_COUNT; ++color) {
+            table.upcoming[slot][color] = nextKey(state);
+        }
+    }
+    return table;
+}
+
+inline constexpr KeyTable KEYS = makeKeyTable();
+
+inline uint64_t cellKey(int index, BallColor color) {
+    return KEYS.cell[static_cast<int>(color)][index];
+}
+
+// XOR into a board hash to include the colour waiting in the given upcoming slot.
+inline uint64_t upcomingKey(int slot, BallColor color) {
+    return KEYS.upcoming[slot][static_cast<int>(color)];
+}
+
+} // namespace Zobrist
+
+} // namespace colorlines
+
+#endif //COLORLINES_ZOBRIST_H
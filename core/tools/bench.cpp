@@ -0,0 +1,192 @@
+// Micro-benchmarks for the core engine.
+// Usage: bench [iterations]
+#include "BoardBatch.h"
+#include "GameGrid.h"
+#include "LinePotential.h"
+#include "LineWindows.h"
+#include "PackedBoard.h"
+#include "Pathfinder.h"
+#include "Rules.h"
+#include "RunScanner.h"
+#include "Snapshot.h"
+#include "Solver.h"
+#include "TiledScanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace colorlines;
+
+namespace {
+
+volatile long g_sink; // Keeps results alive so the work is not optimised away
+
+template <typename Fn>
+void run(const char* name, long iterations, Fn fn) {
+    long sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        sink += fn(i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    g_sink = sink;
+    std::printf("%-30s %10.1f ns/op\n", name, ns / iterations);
+}
+
+// Giant-board line scan throughput for every kernel the CPU supports.
+void benchRunScanner(int side, int repeats) {
+    std::vector<BallColor> cells(size_t(side) * side);
+    std::mt19937 rng(side);
+    for (BallColor& cell : cells) {
+        cell = static_cast<BallColor>(rng() % 4); // Three colours plus empty, so runs are common
+    }
+    std::vector<uint8_t> clearMask(cells.size());
+    for (int kernel = RunScanner::SCALAR; kernel <= RunScanner::AVX2; ++kernel) {
+        if (!RunScanner::isSupported(static_cast<RunScanner::Kernel>(kernel))) continue;
+        RunScanner scanner(static_cast<RunScanner::Kernel>(kernel));
+        scanner.scan(cells.data(), side, side, 5, clearMask.data()); // Warm-up, sizes the scratch mask
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            scanner.scan(cells.data(), side, side, 5, clearMask.data());
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        g_sink = clearMask[side];
+        std::printf("RunScanner %4dx%-4d %-6s %6.2f cells/ns\n", side, side, scanner.getKernelName(),
+                    double(cells.size()) * repeats / ns);
+    }
+
+    TiledScanner tiled;
+    tiled.scan(cells.data(), side, side, 5, clearMask.data()); // Warm-up, sizes the band masks
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        tiled.scan(cells.data(), side, side, 5, clearMask.data());
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    g_sink = clearMask[side];
+    std::printf("TiledScanner %4dx%-4d %2d threads %6.2f cells/ns\n", side, side, tiled.getThreadCount(),
+                double(cells.size()) * repeats / ns);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+
+    Board<9, 9> board;
+    board.setRngState(42);
+    board.addRandomBalls(40);
+    Solver<9, 9> solver(&board);
+    Pathfinder<9, 9> pathfinder(&board);
+
+    run("board copy", iterations, [&](long i) {
+        Board<9, 9> copy = board;
+        return static_cast<long>(copy.getEmptyCount() + i);
+    });
+    run("findLines", iterations, [&](long) {
+        return static_cast<long>(solver.findLines().size());
+    });
+    run("findLineMask", iterations, [&](long) {
+        return static_cast<long>(solver.findLineMask().count());
+    });
+    std::vector<std::pair<int, int>> spawned = {{0, 0}, {4, 4}, {8, 2}};
+    run("findLinesThrough 3 cells", iterations, [&](long) {
+        return static_cast<long>(solver.findLinesThrough(spawned).size());
+    });
+    run("RuleEngine findLines", iterations, [&](long) {
+        return static_cast<long>(RuleEngine<FlatRules, 9, 9>::findLines(board).count());
+    });
+    run("RuleEngine findLinesThrough", iterations, [&](long i) {
+        return static_cast<long>(RuleEngine<FlatRules, 9, 9>::findLinesThrough(board, Bitboard::bit(i % 81)).count());
+    });
+    run("windows through a cell", iterations, [&](long i) {
+        // Fullest window of the cell's colour that no other colour blocks
+        int cell = static_cast<int>(i % 81);
+        BallColor color = board.getColor(cell);
+        Bitboard blockers = board.getOccupied() & ~board.getColorMask(color);
+        int best = 0;
+        for (int w = 0; w < LINE_WINDOWS_9X9.windowCountThrough(cell); ++w) {
+            const Bitboard& window = LINE_WINDOWS_9X9.windows[LINE_WINDOWS_9X9.windowsThrough(cell)[w]].mask;
+            if ((window & blockers).none()) best = std::max(best, (window & board.getColorMask(color)).count());
+        }
+        return static_cast<long>(best);
+    });
+    {
+        // Place and take back a ball, keeping the open-window counts in step both times
+        Board<9, 9> scratch = board;
+        LinePotential<9, 9> potential(&scratch);
+        run("LinePotential place + remove", iterations, [&](long i) {
+            int cell = scratch.getEmptyCell(static_cast<int>(i % scratch.getEmptyCount()));
+            scratch.placeBall(cell / 9, cell % 9, BallColor::RED);
+            potential.cellChanged(cell, BallColor::EMPTY);
+            long open = potential.getOpenCount(4);
+            scratch.removeBall(cell / 9, cell % 9);
+            potential.cellChanged(cell, BallColor::RED);
+            return open;
+        });
+    }
+    run("canReach", iterations, [&](long i) {
+        int from = static_cast<int>(i % 81);
+        int to = board.getEmptyCell(static_cast<int>(i % board.getEmptyCount()));
+        return static_cast<long>(pathfinder.canReach(from / 9, from % 9, to / 9, to % 9));
+    });
+    run("reset + spawn 40", iterations / 10, [&](long) {
+        Board<9, 9> scratch;
+        scratch.addRandomBalls(40);
+        return static_cast<long>(scratch.getEmptyCount());
+    });
+    Snapshot<Board<9, 9>> snapshot(board);
+    Board<9, 9> snapshotCopy;
+    run("snapshot publish", iterations, [&](long) {
+        snapshot.publish(board);
+        return 1L;
+    });
+    run("snapshot read", iterations, [&](long) {
+        snapshot.read(snapshotCopy);
+        return static_cast<long>(snapshotCopy.getEmptyCount());
+    });
+
+    // Raw codec throughput over a block of 1024 boards (82944 cells) per call
+    const int BLOCK = 1024;
+    static BallColor cells[BLOCK * 81];
+    static unsigned char packed[BLOCK * 41];
+    for (int i = 0; i < BLOCK; ++i) {
+        board.getCells(cells + i * 81);
+    }
+    run("packCells, 1024 boards", iterations / BLOCK + 1, [&](long) {
+        packCells(cells, BLOCK * 81, packed);
+        return static_cast<long>(packed[0]);
+    });
+    run("unpackCells, 1024 boards", iterations / BLOCK + 1, [&](long) {
+        unpackCells(packed, BLOCK * 81, cells);
+        return static_cast<long>(cells[0]);
+    });
+    PackedBoard<9, 9> packedBoard(board);
+    Board<9, 9> unpacked;
+    run("PackedBoard unpack", iterations, [&](long) {
+        packedBoard.unpack(unpacked);
+        return static_cast<long>(unpacked.getEmptyCount());
+    });
+
+    // Lockstep simulators: one findLines over 4096 boards, reported per call
+    const int BATCH = 4096;
+    BoardBatch batch(9, 9, BATCH);
+    for (int b = 0; b < BATCH; ++b) {
+        Board<9, 9> scratch;
+        scratch.setRngState(b);
+        scratch.addRandomBalls(40);
+        batch.loadBoard(b, scratch);
+    }
+    std::vector<Bitboard> batchMasks(BATCH);
+    run("BoardBatch, 4096 boards", iterations / BATCH + 1, [&](long) {
+        batch.findLines(5);
+        batch.getClearMasks(batchMasks.data());
+        return static_cast<long>(batchMasks[0].count());
+    });
+
+    benchRunScanner(512, 20);
+    benchRunScanner(4096, 2);
+    return 0;
+}
@@ -0,0 +1,353 @@
+// Consistency checks for the engine. The alternative line finders must give exactly the
+// cells the single-board Solver does (TiledScanner, for boards beyond a Bitboard, the cells
+// of one serial RunScanner pass), reachability must agree with a plain BFS, undoing turns must restore the board exactly, and packed
+// positions must unpack to the board they came from.
+// Exits non-zero on the first mismatch.
+// Usage: check [boards] [seed]
+#include "BoardBatch.h"
+#include "EmptyRegions.h"
+#include "GameGrid.h"
+#include "MoveJournal.h"
+#include "PackedBoard.h"
+#include "Pathfinder.h"
+#include "Rules.h"
+#include "RunScanner.h"
+#include "Solver.h"
+#include "TiledScanner.h"
+#include "TurnResolver.h"
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace colorlines;
+
+namespace {
+
+// Fills 'board' with 'balls' random balls of the first 'colors' colours; few colours and a
+// dense board make long and crossing lines common.
+template <class BoardType>
+void randomBoard(BoardType& board, uint64_t seed, int balls, int colors) {
+    board.reset();
+    board.setRngState(seed);
+    board.setSpawnColorCount(colors);
+    board.addRandomBalls(balls);
+}
+
+// BoardBatch::findLines() against Solver::findLineMask() on every board of a batch.
+template <int Width, int Height>
+bool checkBoardBatch(int width, int height, int boardCount, uint64_t seed) {
+    std::vector<Board<Width, Height>> boards(boardCount, Board<Width, Height>(width, height));
+    BoardBatch batch(width, height, boardCount);
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(boards[b], seed + b, b % (width * height + 1), 2 + b % 4);
+        batch.loadBoard(b, boards[b]);
+    }
+    for (int minLength = 1; minLength <= 7; ++minLength) {
+        batch.findLines(minLength);
+        for (int b = 0; b < boardCount; ++b) {
+            Solver<Width, Height> solver(&boards[b]);
+            if (batch.getClearMask(b) != solver.findLineMask(minLength)) {
+                std::printf("BoardBatch %dx%d: board %d differs from Solver at minLength %d\n", width, height, b,
+                            minLength);
+                return false;
+            }
+        }
+    }
+    std::printf("BoardBatch %dx%d: %d boards match Solver\n", width, height, boardCount);
+    return true;
+}
+
+// RuleEngine's compile-time path against Solver::findLineMask() on single boards.
+template <int Width, int Height>
+bool checkRuleEngine(int boardCount, uint64_t seed) {
+    Board<Width, Height> board;
+    Solver<Width, Height> solver(&board);
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(board, seed + b, b % (Width * Height + 1), 2 + b % 4);
+        if (RuleEngine<FlatRules, Width, Height>::findLines(board) != solver.findLineMask(FlatRules::MIN_LENGTH)) {
+            std::printf("RuleEngine %dx%d: board %d differs from Solver\n", Width, Height, b);
+            return false;
+        }
+    }
+    std::printf("RuleEngine %dx%d: %d boards match Solver\n", Width, Height, boardCount);
+    return true;
+}
+
+// RunScanner's byte masks against Solver::findLineMask() on the same boards.
+template <int Width, int Height>
+bool checkRunScanner(int width, int height, int boardCount, uint64_t seed) {
+    Board<Width, Height> board(width, height);
+    Solver<Width, Height> solver(&board);
+    RunScanner scanner;
+    std::vector<BallColor> cells(width * height);
+    std::vector<uint8_t> clearMask(cells.size());
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(board, seed + b, b % (width * height + 1), 2 + b % 4);
+        board.getCells(cells.data());
+        for (int minLength = 1; minLength <= 7; ++minLength) {
+            scanner.scan(cells.data(), width, height, minLength, clearMask.data());
+            Bitboard expected = solver.findLineMask(minLength);
+            for (int index = 0; index < width * height; ++index) {
+                if ((clearMask[index] != 0) != expected.test(index)) {
+                    std::printf("RunScanner %dx%d: board %d differs from Solver at minLength %d\n", width, height,
+                                b, minLength);
+                    return false;
+                }
+            }
+        }
+    }
+    std::printf("RunScanner %dx%d: %d boards match Solver\n", width, height, boardCount);
+    return true;
+}
+
+// TiledScanner with several bands against one RunScanner pass over the whole board.
+bool checkTiledScanner(int width, int height, int threadCount, uint64_t seed) {
+    std::vector<BallColor> cells(size_t(width) * height);
+    std::mt19937_64 rng(seed);
+    for (BallColor& cell : cells) {
+        cell = static_cast<BallColor>(rng() % 4); // Three colours plus empty, so runs are common
+    }
+    std::vector<uint8_t> expected(cells.size());
+    std::vector<uint8_t> tiledMask(cells.size());
+    RunScanner scanner;
+    TiledScanner tiled(threadCount);
+    for (int minLength = 1; minLength <= 9; ++minLength) {
+        scanner.scan(cells.data(), width, height, minLength, expected.data());
+        tiled.scan(cells.data(), width, height, minLength, tiledMask.data());
+        if (tiledMask != expected) {
+            std::printf("TiledScanner %dx%d, %d threads: differs from RunScanner at minLength %d\n", width, height,
+                        threadCount, minLength);
+            return false;
+        }
+    }
+    std::printf("TiledScanner %dx%d, %d threads: matches RunScanner\n", width, height, threadCount);
+    return true;
+}
+
+// True if two boards hold the same position and will play on identically: colour and
+// occupancy masks, hash, spawn RNG and the live part of the empty-cell list (entries past
+// the empty count are stale and may differ).
+template <int Width, int Height>
+bool sameState(const Board<Width, Height>& a, const Board<Width, Height>& b) {
+    if (a.getOccupied() != b.getOccupied() || a.getHash() != b.getHash() || a.getRngState() != b.getRngState() ||
+        a.getEmptyCount() != b.getEmptyCount()) {
+        return false;
+    }
+    for (int color = 0; color < BALL_COLOR_COUNT; ++color) {
+        if (a.getColorMasks()[color] != b.getColorMasks()[color]) return false;
+    }
+    for (int slot = 0; slot < a.getEmptyCount(); ++slot) {
+        int cell = a.getEmptyCell(slot);
+        if (cell != b.getEmptyCell(slot) || a.getEmptySlot(cell) != b.getEmptySlot(cell)) return false;
+    }
+    return true;
+}
+
+// Plays random turns through a MoveJournal, then undoes them one by one; after each undo
+// the board must equal the copy taken before that turn, and the turn's score comes back.
+template <int Width, int Height>
+bool checkMoveJournal(int games, uint64_t seed) {
+    Board<Width, Height> board;
+    MoveJournal<Width, Height> journal(&board);
+    TurnResolver<FlatRules, Width, Height> resolver(&board, &journal);
+    std::mt19937_64 rng(seed);
+    const int cellCount = Width * Height;
+    for (int game = 0; game < games; ++game) {
+        board.reset();
+        board.setRngState(seed + game);
+        board.setSpawnColorCount(2 + game % 4);
+        journal.clear();
+        resolver.spawnBalls(5);
+
+        std::vector<Board<Width, Height>> before;
+        std::vector<int> scores;
+        int score = 0;
+        while (!board.isFull() && before.size() < 200) {
+            int from = static_cast<int>(rng() % cellCount);
+            if (board.getColor(from) == BallColor::EMPTY) continue;
+            int to = board.getEmptyCell(static_cast<int>(rng() % board.getEmptyCount()));
+            before.push_back(board);
+            scores.push_back(score);
+            journal.beginTurn(score);
+            score += resolver.playTurn(from, to, 3).score;
+        }
+        while (journal.canUndo()) {
+            int restoredScore = journal.undoTurn();
+            if (!sameState(board, before.back()) || restoredScore != scores.back()) {
+                std::printf("MoveJournal %dx%d: game %d, undoing turn %zu does not restore the board\n", Width,
+                            Height, game, before.size());
+                return false;
+            }
+            before.pop_back();
+            scores.pop_back();
+        }
+    }
+    std::printf("MoveJournal %dx%d: %d games undone exactly\n", Width, Height, games);
+    return true;
+}
+
+// PackedBoard encode/decode round trip on random boards of every fill and colour count.
+template <int Width, int Height>
+bool checkPackedBoard(int boardCount, uint64_t seed) {
+    Board<Width, Height> board;
+    Board<Width, Height> unpacked;
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(board, seed + b, b % (Width * Height + 1), 1 + b % (BALL_COLOR_COUNT - 1));
+        PackedBoard<Width, Height> packed(board);
+        packed.unpack(unpacked);
+        bool same = unpacked.getOccupied() == board.getOccupied() && unpacked.getHash() == board.getHash() &&
+                    PackedBoard<Width, Height>(unpacked) == packed;
+        for (int index = 0; same && index < Width * Height; ++index) {
+            same = unpacked.getColor(index) == board.getColor(index) && packed.getColor(index) == board.getColor(index);
+        }
+        if (!same) {
+            std::printf("PackedBoard %dx%d: board %d does not round-trip\n", Width, Height, b);
+            return false;
+        }
+    }
+    std::printf("PackedBoard %dx%d: %d boards round-trip\n", Width, Height, boardCount);
+    return true;
+}
+
+// Empty cells a ball on 'start' can move to, by breadth-first search over orthogonal
+// neighbours as the original pathfinder did. visited[start] is set as well.
+template <class BoardType>
+std::vector<bool> bfsReachable(const BoardType& board, int start) {
+    int width = board.getWidth();
+    int height = board.getHeight();
+    std::vector<bool> visited(width * height, false);
+    std::queue<int> queue;
+    visited[start] = true;
+    queue.push(start);
+    while (!queue.empty()) {
+        int cell = queue.front();
+        queue.pop();
+        int r = cell / width;
+        int c = cell % width;
+        const int dr[] = {-1, 1, 0, 0};
+        const int dc[] = {0, 0, -1, 1};
+        for (int i = 0; i < 4; ++i) {
+            int nextR = r + dr[i];
+            int nextC = c + dc[i];
+            if (nextR < 0 || nextR >= height || nextC < 0 || nextC >= width) continue;
+            int next = nextR * width + nextC;
+            if (!visited[next] && board.isCellEmpty(nextR, nextC)) {
+                visited[next] = true;
+                queue.push(next);
+            }
+        }
+    }
+    return visited;
+}
+
+// Pathfinder's canReach() and getReachableCells() against bfsReachable(). One pathfinder follows the board through fresh
+// positions and single-cell edits, so stale cached regions would show up as well.
+template <int Width, int Height>
+bool checkPathfinder(int width, int height, int boardCount, uint64_t seed) {
+    Board<Width, Height> board(width, height);
+    Pathfinder<Width, Height> pathfinder(&board);
+    std::mt19937_64 rng(seed);
+    int cellCount = width * height;
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(board, seed + b, b % (cellCount + 1), 3);
+        for (int edit = 0; edit < 8; ++edit) {
+            int start = static_cast<int>(rng() % cellCount);
+            std::vector<bool> reachable = bfsReachable(board, start);
+            Bitboard expected; // Destinations: the BFS cells other than the start
+            for (int end = 0; end < cellCount; ++end) {
+                if (reachable[end] && end != start) expected.set(end);
+            }
+            if (pathfinder.getReachableCells(start / width, start % width) != expected) {
+                std::printf("Pathfinder %dx%d: board %d, getReachableCells(%d) differs from BFS\n", width, height,
+                            b, start);
+                return false;
+            }
+            for (int end = 0; end < cellCount; ++end) {
+                if (!board.isCellEmpty(end / width, end % width)) continue; // Callers only ask for empty targets
+                if (pathfinder.canReach(start / width, start % width, end / width, end % width) != reachable[end]) {
+                    std::printf("Pathfinder %dx%d: board %d, canReach %d -> %d differs from BFS\n", width, height,
+                                b, start, end);
+                    return false;
+                }
+            }
+            // Toggle one cell, so the next queries run against a slightly different position
+            int cell = static_cast<int>(rng() % cellCount);
+            if (board.isCellEmpty(cell / width, cell % width)) {
+                board.placeBall(cell / width, cell % width, board.randomColor());
+            } else {
+                board.removeBall(cell / width, cell % width);
+            }
+        }
+    }
+    std::printf("Pathfinder %dx%d: %d boards match BFS\n", width, height, boardCount);
+    return true;
+}
+
+// EmptyRegions labelling against bfsReachable(): occupied cells get label 0, and each empty
+// cell's region is exactly its BFS component, with one label per component.
+template <int Width, int Height>
+bool checkEmptyRegions(int width, int height, int boardCount, uint64_t seed) {
+    Board<Width, Height> board(width, height);
+    EmptyRegions<Width, Height> regions(&board);
+    int cellCount = width * height;
+    for (int b = 0; b < boardCount; ++b) {
+        randomBoard(board, seed + b, b % (cellCount + 1), 3);
+        int components = 0;
+        Bitboard labelled;
+        bool same = true;
+        for (int cell = 0; same && cell < cellCount; ++cell) {
+            int label = regions.getLabel(cell);
+            if (!board.isCellEmpty(cell / width, cell % width)) {
+                same = label == 0;
+                continue;
+            }
+            if (labelled.test(cell)) continue; // Its component was compared already
+            std::vector<bool> component = bfsReachable(board, cell);
+            Bitboard expected;
+            for (int other = 0; other < cellCount; ++other) {
+                if (component[other]) expected.set(other);
+            }
+            ++components;
+            labelled |= expected;
+            same = label >= 1 && label <= regions.getRegionCount() && regions.getRegion(label) == expected;
+        }
+        if (!same || components != regions.getRegionCount()) {
+            std::printf("EmptyRegions %dx%d: board %d differs from BFS\n", width, height, b);
+            return false;
+        }
+    }
+    std::printf("EmptyRegions %dx%d: %d boards match BFS\n", width, height, boardCount);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int boards = argc > 1 ? std::atoi(argv[1]) : 2000;
+    uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+
+    bool ok = checkMoveJournal<9, 9>(boards / 10, seed) &&
+              checkMoveJournal<7, 7>(boards / 10, seed) &&
+              checkPackedBoard<9, 9>(boards, seed) &&
+              checkPackedBoard<7, 7>(boards, seed) &&
+              checkPackedBoard<11, 11>(boards, seed) &&
+              checkPathfinder<9, 9>(9, 9, boards, seed) &&
+              checkPathfinder<DYNAMIC_SIZE, DYNAMIC_SIZE>(11, 7, boards, seed) &&
+              checkEmptyRegions<9, 9>(9, 9, boards, seed) &&
+              checkEmptyRegions<DYNAMIC_SIZE, DYNAMIC_SIZE>(11, 7, boards, seed) &&
+              checkRuleEngine<9, 9>(boards, seed) &&
+              checkRuleEngine<11, 11>(boards, seed) &&
+              checkBoardBatch<9, 9>(9, 9, boards, seed) &&
+              checkBoardBatch<11, 11>(11, 11, boards, seed) &&
+              checkBoardBatch<DYNAMIC_SIZE, DYNAMIC_SIZE>(11, 7, boards, seed) &&
+              checkBoardBatch<DYNAMIC_SIZE, DYNAMIC_SIZE>(1, 9, 64, seed) &&
+              checkRunScanner<9, 9>(9, 9, boards, seed) &&
+              checkRunScanner<DYNAMIC_SIZE, DYNAMIC_SIZE>(11, 7, boards, seed) &&
+              checkTiledScanner(512, 512, 4, seed) &&
+              checkTiledScanner(512, 512, 16, seed) &&
+              checkTiledScanner(300, 731, 7, seed) &&
+              checkTiledScanner(37, 2000, 3, seed);
+    return ok ? 0 : 1;
+}
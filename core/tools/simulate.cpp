@@ -0,0 +1,130 @@
+// Headless self-play: a bot plays complete games on the core engine.
+// Usage: simulate [games] [seed] [random|greedy]
+#include "GameGrid.h"
+#include "LinePotential.h"
+#include "LineWindows.h"
+#include "Pathfinder.h"
+#include "TurnResolver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using namespace colorlines;
+
+namespace {
+
+// Heuristic value of moving a ball of 'color' from 'vacated' to 'cell': over the windows of
+// five through 'cell' that hold no other colour, the sum of squared same-colour counts.
+int placementValue(const Board<9, 9>& board, int cell, BallColor color, int vacated) {
+    const auto& table = LINE_WINDOWS_9X9;
+    Bitboard keep = ~Bitboard::bit(vacated);
+    Bitboard same = board.getColorMask(color) & keep;
+    Bitboard blockers = board.getOccupied() & ~board.getColorMask(color) & keep;
+    int value = 0;
+    for (int i = 0; i < table.windowCountThrough(cell); ++i) {
+        const Bitboard& window = table.windows[table.windowsThrough(cell)[i]].mask;
+        if ((window & blockers).none()) {
+            int count = (window & same).count();
+            value += count * count;
+        }
+    }
+    return value;
+}
+
+struct GameStats {
+    long turns = 0;
+    long score = 0;
+    bool potentialConsistent = true; // LinePotential kept up through the game matches a recount
+};
+
+// Plays one game. The random bot plays the first reachable move it samples; the greedy
+// bot tries every destination of up to 8 sampled balls and plays the best by
+// placementValue(). A LinePotential follows every turn and is checked at the end.
+GameStats playGame(Board<9, 9>& board, std::mt19937_64& botRng, bool greedy) {
+    TurnResolver<FlatRules, 9, 9> resolver(&board);
+    Pathfinder<9, 9> pathfinder(&board);
+    GameStats stats;
+
+    board.reset();
+    LinePotential<9, 9> potential(&board);
+    potential.apply(resolver.spawnBalls(5));
+    while (!board.isFull()) {
+        int from = -1;
+        int to = -1;
+        if (greedy) {
+            // Every legal destination of up to 8 sampled balls, one reachability mask per ball
+            int bestValue = -1;
+            int balls = 0;
+            for (int attempt = 0; attempt < 64 && balls < 8; ++attempt) {
+                int cell = static_cast<int>(botRng() % 81);
+                if (board.getColor(cell) == BallColor::EMPTY) continue;
+                Bitboard targets = pathfinder.getReachableCells(cell / 9, cell % 9);
+                if (targets.none()) continue;
+                ++balls;
+                while (targets.any()) {
+                    int target = targets.popLowestBit();
+                    int value = placementValue(board, target, board.getColor(cell), cell);
+                    if (value > bestValue) {
+                        bestValue = value;
+                        from = cell;
+                        to = target;
+                    }
+                }
+            }
+        } else {
+            // Sample random balls and random empty cells until a move is reachable
+            for (int attempt = 0; attempt < 64 && to < 0; ++attempt) {
+                int cell = static_cast<int>(botRng() % 81);
+                if (board.getColor(cell) == BallColor::EMPTY) continue;
+                int target = board.getEmptyCell(static_cast<int>(botRng() % board.getEmptyCount()));
+                if (pathfinder.canReach(cell / 9, cell % 9, target / 9, target % 9)) {
+                    from = cell;
+                    to = target;
+                }
+            }
+        }
+        if (to < 0) break; // Bot is stuck
+
+        TurnResult result = resolver.playTurn(from, to, 3);
+        potential.apply(result);
+        ++stats.turns;
+        stats.score += result.score;
+    }
+    stats.potentialConsistent = potential.isConsistent();
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? std::atoi(argv[1]) : 1000;
+    unsigned long seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+    bool greedy = argc > 3 && std::strcmp(argv[3], "greedy") == 0;
+
+    Board<9, 9> board;
+    board.setRngState(seed);
+    std::mt19937_64 botRng(seed);
+
+    long totalTurns = 0;
+    long totalScore = 0;
+    int inconsistentGames = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int game = 0; game < games; ++game) {
+        GameStats result = playGame(board, botRng, greedy);
+        totalTurns += result.turns;
+        totalScore += result.score;
+        inconsistentGames += !result.potentialConsistent;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("games: %d  turns: %ld  avg score: %.2f\n", games, totalTurns,
+                games ? static_cast<double>(totalScore) / games : 0.0);
+    std::printf("time: %.3f s  turns/s: %.0f\n", seconds, seconds > 0 ? totalTurns / seconds : 0.0);
+    if (inconsistentGames) {
+        std::printf("LinePotential disagreed with a recount after %d games\n", inconsistentGames);
+        return 1;
+    }
+    return 0;
+}